@@ -0,0 +1,249 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_CONCURRENTSIGNALSTATS_HH_
+#define IGNITION_MATH_CONCURRENTSIGNALSTATS_HH_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include <ignition/math/StaticSignalStats.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class ConcurrentSignalStats ConcurrentSignalStats.hh
+    /// ignition/math/ConcurrentSignalStats.hh
+    /// \brief Statistics of a scalar signal that several threads insert
+    /// data into concurrently, without locks.
+    ///
+    /// Each writer owns a shard, selected by a writer index, that holds
+    /// the state of a StaticSignalStats<Stats...>. Shards are aligned to
+    /// cache lines so writers do not contend with each other. After each
+    /// insertion, the writer publishes its state under a sequence lock.
+    /// Writers never wait. Readers copy each shard and retry if a writer
+    /// published while they were copying, then merge the shards. Every
+    /// shard in the snapshot is therefore consistent, and holds all the
+    /// data its writer inserted before some point during the read.
+    ///
+    /// Each writer index must be used by at most one thread at a time.
+    /// Reads can happen from any number of threads.
+    ///
+    /// ## Example usage
+    ///
+    /// \code{.cpp}
+    /// ConcurrentSignalStats<stats::Mean, stats::Maximum> s(2);
+    /// // In writer thread 0
+    /// s.InsertData(0, 1.0);
+    /// // In writer thread 1
+    /// s.InsertData(1, 3.0);
+    /// // In any thread
+    /// double mean = s.Snapshot().Value<stats::Mean>();
+    /// \endcode
+    template<typename... Stats>
+    class ConcurrentSignalStats
+    {
+      static_assert(std::is_trivially_copyable<SignalStatsState>::value,
+          "SignalStatsState must be trivially copyable");
+
+      /// \brief Constructor.
+      /// \param[in] _writers Number of writers. This value will be ignored
+      /// if it is equal to zero, and one writer is used.
+      public: explicit ConcurrentSignalStats(unsigned int _writers = 1)
+        : writers(_writers > 0 ? _writers : 1),
+          shards(new Shard[this->writers])
+      {
+      }
+
+      /// \brief Get the number of writers.
+      /// \return Number of writers.
+      public: unsigned int Writers() const
+      {
+        return this->writers;
+      }
+
+      /// \brief Add a new sample to all statistics.
+      /// \param[in] _writer Index of the writer, less than Writers().
+      /// \param[in] _data New signal data point.
+      /// \return False if _writer is out of range.
+      public: bool InsertData(unsigned int _writer, const double _data)
+      {
+        if (_writer >= this->writers)
+          return false;
+
+        Shard &shard = this->shards[_writer];
+        shard.local.InsertData(_data);
+        Publish(shard);
+        return true;
+      }
+
+      /// \brief Add a block of samples to all statistics. The block is
+      /// published once, so readers see all of it or none of it.
+      /// \param[in] _writer Index of the writer, less than Writers().
+      /// \param[in] _data New signal data points.
+      /// \return False if _writer is out of range.
+      public: bool InsertData(unsigned int _writer,
+                  const std::vector<double> &_data)
+      {
+        if (_writer >= this->writers)
+          return false;
+
+        Shard &shard = this->shards[_writer];
+        for (const double data : _data)
+          shard.local.InsertData(data);
+        Publish(shard);
+        return true;
+      }
+
+      /// \brief Get a consistent snapshot of the data of all writers.
+      /// \return Merged statistics.
+      public: StaticSignalStats<Stats...> Snapshot() const
+      {
+        StaticSignalStats<Stats...> result;
+        for (unsigned int i = 0; i < this->writers; ++i)
+          result.Merge(StaticSignalStats<Stats...>(Read(this->shards[i])));
+        return result;
+      }
+
+      /// \brief Get a consistent snapshot of the data of one writer.
+      /// \param[in] _writer Index of the writer.
+      /// \return Statistics of the writer, or empty statistics if _writer
+      /// is out of range.
+      public: StaticSignalStats<Stats...> Snapshot(unsigned int _writer) const
+      {
+        if (_writer >= this->writers)
+          return StaticSignalStats<Stats...>();
+        return StaticSignalStats<Stats...>(Read(this->shards[_writer]));
+      }
+
+      /// \brief Get number of data points of all writers.
+      /// \return Number of data points.
+      public: size_t Count() const
+      {
+        return this->Snapshot().Count();
+      }
+
+      /// \brief Get the current values of each statistical measure,
+      /// stored in a map using the short name as the key.
+      /// \return Map with short name of each statistic as key
+      /// and value of statistic as the value.
+      public: std::map<std::string, double> Map() const
+      {
+        return this->Snapshot().Map();
+      }
+
+      /// \brief Forget all previous data. This must not be called while
+      /// any writer is inserting data.
+      public: void Reset()
+      {
+        for (unsigned int i = 0; i < this->writers; ++i)
+        {
+          this->shards[i].local.Reset();
+          Publish(this->shards[i]);
+        }
+      }
+
+      /// \brief Number of 64 bit words of a published state.
+      private: static constexpr size_t kWords =
+        (sizeof(SignalStatsState) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+      /// \brief State of one writer, on its own cache lines.
+      private: struct alignas(64) Shard
+      {
+        /// \brief Sequence number, odd while the state is being published.
+        std::atomic<uint64_t> sequence{0};
+
+        /// \brief Published copy of the state.
+        std::array<std::atomic<uint64_t>, kWords> words{};
+
+        /// \brief State only accessed by the writer.
+        StaticSignalStats<Stats...> local;
+      };
+
+      /// \brief Publish the state of the writer of a shard.
+      /// \param[in] _shard Shard to publish.
+      private: static void Publish(Shard &_shard)
+      {
+        std::array<uint64_t, kWords> buffer{};
+        std::memcpy(buffer.data(), &_shard.local.State(),
+            sizeof(SignalStatsState));
+
+        const uint64_t sequence =
+          _shard.sequence.load(std::memory_order_relaxed);
+        _shard.sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        for (size_t i = 0; i < kWords; ++i)
+          _shard.words[i].store(buffer[i], std::memory_order_relaxed);
+        _shard.sequence.store(sequence + 2, std::memory_order_release);
+      }
+
+      /// \brief Read the published state of a shard.
+      /// \param[in] _shard Shard to read.
+      /// \return Copy of the state.
+      private: static SignalStatsState Read(const Shard &_shard)
+      {
+        // Number of failed attempts after which the reader yields, in case
+        // the writer was preempted while publishing
+        const unsigned int kSpinsBeforeYield = 16;
+
+        std::array<uint64_t, kWords> buffer{};
+        for (unsigned int spins = 0; ; ++spins)
+        {
+          if (spins >= kSpinsBeforeYield)
+            std::this_thread::yield();
+
+          const uint64_t before =
+            _shard.sequence.load(std::memory_order_acquire);
+          if (before % 2 == 1)
+            continue;
+
+          for (size_t i = 0; i < kWords; ++i)
+            buffer[i] = _shard.words[i].load(std::memory_order_relaxed);
+          std::atomic_thread_fence(std::memory_order_acquire);
+
+          if (_shard.sequence.load(std::memory_order_relaxed) == before)
+            break;
+        }
+
+        SignalStatsState state;
+        std::memcpy(static_cast<void *>(&state), buffer.data(),
+            sizeof(SignalStatsState));
+        return state;
+      }
+
+      /// \brief Number of writers.
+      private: unsigned int writers;
+
+      /// \brief One shard per writer.
+      private: std::unique_ptr<Shard[]> shards;
+    };
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,174 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_CONSTANTVELOCITYTRACKERBANK_HH_
+#define IGNITION_MATH_CONSTANTVELOCITYTRACKERBANK_HH_
+
+#include <memory>
+#include <vector>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class ConstantVelocityTrackerBankPrivate;
+
+    /// \class ConstantVelocityTrackerBank ConstantVelocityTrackerBank.hh
+    /// ignition/math/ConstantVelocityTrackerBank.hh
+    /// \brief A bank of 3D constant velocity Kalman filters that track
+    /// many targets from position measurements.
+    ///
+    /// The state of each track is a position and a velocity. The motion
+    /// model is driven by white noise acceleration, independent on each
+    /// axis, and position measurements have independent noise on each
+    /// axis. The 6x6 covariance of a track is therefore made of three
+    /// independent 2x2 position-velocity blocks, one per axis, and only
+    /// the three distinct values of each block are stored. States and
+    /// covariances of all tracks are stored as a structure of arrays, so
+    /// Predict and Update are plain loops over all tracks and axes.
+    class IGNITION_MATH_VISIBLE ConstantVelocityTrackerBank
+    {
+      /// \brief Constructor. The process noise and the measurement noise
+      /// are one.
+      public: ConstantVelocityTrackerBank();
+
+      /// \brief Constructor.
+      /// \param[in] _processNoise Spectral density of the acceleration
+      /// noise on each axis, in m^2/s^3.
+      /// \param[in] _measurementNoise Variance of the position
+      /// measurements on each axis, in m^2.
+      public: ConstantVelocityTrackerBank(double _processNoise,
+                  double _measurementNoise);
+
+      /// \brief Destructor.
+      public: ~ConstantVelocityTrackerBank();
+
+      /// \brief Get the spectral density of the acceleration noise.
+      /// \return Process noise.
+      public: double ProcessNoise() const;
+
+      /// \brief Set the spectral density of the acceleration noise.
+      /// Negative values are replaced by zero.
+      /// \param[in] _noise Process noise.
+      public: void SetProcessNoise(double _noise);
+
+      /// \brief Get the variance of the position measurements.
+      /// \return Measurement noise.
+      public: double MeasurementNoise() const;
+
+      /// \brief Set the variance of the position measurements. Negative
+      /// values are replaced by zero. With zero noise, a measurement of a
+      /// track axis whose position variance is also zero is ignored.
+      /// \param[in] _noise Measurement noise.
+      public: void SetMeasurementNoise(double _noise);
+
+      /// \brief Get the number of tracks.
+      /// \return Number of tracks.
+      public: size_t Count() const;
+
+      /// \brief Add a track.
+      /// \param[in] _position Initial position.
+      /// \param[in] _velocity Initial velocity.
+      /// \param[in] _positionVariance Initial variance of the position on
+      /// each axis.
+      /// \param[in] _velocityVariance Initial variance of the velocity on
+      /// each axis.
+      /// \return Index of the new track.
+      public: size_t AddTrack(const Vector3d &_position,
+                  const Vector3d &_velocity = Vector3d::Zero,
+                  double _positionVariance = 1.0,
+                  double _velocityVariance = 1.0);
+
+      /// \brief Remove a track. The last track is moved to its index.
+      /// \param[in] _index Index of the track.
+      /// \return False if _index is out of range.
+      public: bool RemoveTrack(size_t _index);
+
+      /// \brief Remove all tracks.
+      public: void Clear();
+
+      /// \brief Predict all tracks forward in time.
+      /// \param[in] _dt Time step, in seconds.
+      public: void Predict(double _dt);
+
+      /// \brief Correct all tracks with one position measurement each.
+      /// \param[in] _positions Measured position of each track, in track
+      /// order.
+      /// \return False if the number of positions is not Count(), in which
+      /// case no track is changed.
+      public: bool Update(const std::vector<Vector3d> &_positions);
+
+      /// \brief Correct some tracks with position measurements.
+      /// \param[in] _indices Indices of the measured tracks. Each index
+      /// must appear at most once.
+      /// \param[in] _positions Measured position of each track in
+      /// _indices.
+      /// \return False if the sizes differ or an index is out of range, in
+      /// which case no track is changed.
+      public: bool Update(const std::vector<size_t> &_indices,
+                  const std::vector<Vector3d> &_positions);
+
+      /// \brief Get the estimated position of a track.
+      /// \param[in] _index Index of the track.
+      /// \return Position, or Vector3d::NaN if _index is out of range.
+      public: Vector3d Position(size_t _index) const;
+
+      /// \brief Get the estimated velocity of a track.
+      /// \param[in] _index Index of the track.
+      /// \return Velocity, or Vector3d::NaN if _index is out of range.
+      public: Vector3d Velocity(size_t _index) const;
+
+      /// \brief Get the variance of the position of a track on each axis.
+      /// \param[in] _index Index of the track.
+      /// \return Position variances, or Vector3d::NaN if _index is out of
+      /// range.
+      public: Vector3d PositionVariance(size_t _index) const;
+
+      /// \brief Get the variance of the velocity of a track on each axis.
+      /// \param[in] _index Index of the track.
+      /// \return Velocity variances, or Vector3d::NaN if _index is out of
+      /// range.
+      public: Vector3d VelocityVariance(size_t _index) const;
+
+      /// \brief Get the covariance between position and velocity of a
+      /// track on each axis.
+      /// \param[in] _index Index of the track.
+      /// \return Covariances, or Vector3d::NaN if _index is out of range.
+      public: Vector3d PositionVelocityCovariance(size_t _index) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<ConstantVelocityTrackerBankPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
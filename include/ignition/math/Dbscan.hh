@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_DBSCAN_HH_
+#define IGNITION_MATH_DBSCAN_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class DbscanPrivate;
+
+    /// \class Dbscan Dbscan.hh ignition/math/Dbscan.hh
+    /// \brief Density-based clustering, from Ester et al., "A Density-Based
+    /// Algorithm for Discovering Clusters in Large Spatial Databases with
+    /// Noise", 1996.
+    ///
+    /// A point is a core point if at least MinPoints() points, including
+    /// itself, lie within Epsilon() of it. Core points within Epsilon() of
+    /// each other belong to the same cluster, so clusters can have any
+    /// shape and their number does not need to be known. A point that is
+    /// not a core point joins the cluster of its closest core point within
+    /// Epsilon(), or is labeled as noise if there is none.
+    ///
+    /// Neighbors are found with a grid of cells of size Epsilon(), so each
+    /// query only visits the 27 cells around a point, and clusters are
+    /// merged with a union-find. Both steps can run on several threads,
+    /// see Threads(unsigned int). Results do not depend on the number of
+    /// threads: clusters are numbered in the order of their first core
+    /// point.
+    class IGNITION_MATH_VISIBLE Dbscan
+    {
+      /// \brief Label of the points that belong to no cluster.
+      public: static constexpr int Noise = -1;
+
+      /// \brief Constructor.
+      /// \param[in] _epsilon Radius of the neighborhood of a point.
+      /// \param[in] _minPoints Number of points in the neighborhood of a
+      /// core point, including itself. Zero is replaced by one.
+      public: Dbscan(double _epsilon, unsigned int _minPoints);
+
+      /// \brief Destructor.
+      public: ~Dbscan();
+
+      /// \brief Get the radius of the neighborhood of a point.
+      /// \return Radius.
+      public: double Epsilon() const;
+
+      /// \brief Set the radius of the neighborhood of a point.
+      /// \param[in] _epsilon Radius, positive.
+      public: void Epsilon(double _epsilon);
+
+      /// \brief Get the number of points in the neighborhood of a core
+      /// point.
+      /// \return Number of points, including the core point.
+      public: unsigned int MinPoints() const;
+
+      /// \brief Set the number of points in the neighborhood of a core
+      /// point.
+      /// \param[in] _minPoints Number of points, including the core point.
+      /// Zero is replaced by one.
+      public: void MinPoints(unsigned int _minPoints);
+
+      /// \brief Set the number of threads used by Cluster. The default is
+      /// one.
+      /// \param[in] _threads Number of threads, or zero to use one per
+      /// hardware thread.
+      public: void Threads(unsigned int _threads);
+
+      /// \brief Get the number of threads used by Cluster.
+      /// \return Number of threads.
+      public: unsigned int Threads() const;
+
+      /// \brief Get the number of clusters found by the last call to
+      /// Cluster.
+      /// \return Number of clusters.
+      public: unsigned int ClusterCount() const;
+
+      /// \brief Cluster points.
+      /// \param[in] _points Points.
+      /// \param[out] _labels Cluster of each point, from 0 to
+      /// ClusterCount() - 1, or Noise.
+      /// \return False if Epsilon() is not a positive finite number, or if
+      /// the grid would have more than 2^62 cells.
+      public: bool Cluster(const std::vector<Vector3d> &_points,
+                  std::vector<int> &_labels);
+
+      /// \brief Cluster caller-owned points, without requiring them to be
+      /// in a std::vector. The finite points are copied once into an
+      /// internal array sorted by grid cell, so that the neighbor searches
+      /// read contiguous memory.
+      /// \param[in] _points Array of _count points. Points that are not
+      /// finite are labeled as noise.
+      /// \param[in] _count Number of points.
+      /// \param[out] _labels Array of _count labels, from 0 to
+      /// ClusterCount() - 1, or Noise.
+      /// \return False if a pointer is null, if Epsilon() is not a
+      /// positive finite number, or if the grid would have more than 2^62
+      /// cells.
+      public: bool Cluster(const Vector3d *_points, size_t _count,
+                  int *_labels);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<DbscanPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
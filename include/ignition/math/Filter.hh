@@ -17,6 +17,7 @@
 #ifndef IGNITION_MATH_FILTER_HH_
 #define IGNITION_MATH_FILTER_HH_
 
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Quaternion.hh>
@@ -93,6 +94,23 @@ namespace ignition
         return this->y0;
       }
 
+      /// \brief Filter a block of samples. This gives the same output as
+      /// calling Process on each sample, in a loop without virtual calls.
+      /// \param[in] _in Input samples.
+      /// \param[out] _out Output samples. It is resized to the size of _in,
+      /// and may be the same vector as _in.
+      public: void Process(const std::vector<T> &_in, std::vector<T> &_out)
+      {
+        _out.resize(_in.size());
+        T y = this->y0;
+        for (size_t i = 0; i < _in.size(); ++i)
+        {
+          y = a0 * _in[i] + b1 * y;
+          _out[i] = y;
+        }
+        this->y0 = y;
+      }
+
       /// \brief Input gain control.
       protected: double a0 = 0;
 
@@ -128,6 +146,21 @@ namespace ignition
         y0 = math::Quaterniond::Slerp(a0, y0, _x);
         return y0;
       }
+
+      /// \brief Filter a block of samples.
+      /// \param[in] _in Input samples.
+      /// \param[out] _out Output samples. It is resized to the size of _in,
+      /// and may be the same vector as _in.
+      public: void Process(const std::vector<math::Quaterniond> &_in,
+                  std::vector<math::Quaterniond> &_out)
+      {
+        _out.resize(_in.size());
+        for (size_t i = 0; i < _in.size(); ++i)
+        {
+          y0 = math::Quaterniond::Slerp(a0, y0, _in[i]);
+          _out[i] = y0;
+        }
+      }
     };
 
     /// \class OnePoleVector3 Filter.hh ignition/math/Filter.hh
@@ -214,6 +247,55 @@ namespace ignition
         return this->y0;
       }
 
+      /// \brief Filter a block of samples. This gives the same output as
+      /// calling Process on each sample, but runs a non-virtual loop in
+      /// transposed direct form II, which keeps two state values instead of
+      /// four. Subclasses that override the single sample Process are not
+      /// called.
+      /// \param[in] _in Input samples.
+      /// \param[out] _out Output samples. It is resized to the size of _in,
+      /// and may be the same vector as _in.
+      public: void Process(const std::vector<T> &_in, std::vector<T> &_out)
+      {
+        const size_t n = _in.size();
+        if (n == 0)
+        {
+          _out.clear();
+          return;
+        }
+
+        // The input before the block is needed to restore the state when
+        // the block has a single sample, and _out may alias _in.
+        const T xPrev = this->x1;
+        const T yPrev = this->y1;
+
+        // Convert the direct form I state to transposed direct form II.
+        T s1 = this->a1 * this->x1 + this->a2 * this->x2 -
+               this->b1 * this->y1 - this->b2 * this->y2;
+        T s2 = this->a2 * this->x1 - this->b2 * this->y1;
+
+        _out.resize(n);
+        T xLast = xPrev;
+        T xBeforeLast = xPrev;
+        for (size_t i = 0; i < n; ++i)
+        {
+          const T x = _in[i];
+          const T y = this->a0 * x + s1;
+          s1 = this->a1 * x - this->b1 * y + s2;
+          s2 = this->a2 * x - this->b2 * y;
+          _out[i] = y;
+          xBeforeLast = xLast;
+          xLast = x;
+        }
+
+        // Back to direct form I, so single sample processing can continue.
+        this->x2 = xBeforeLast;
+        this->x1 = xLast;
+        this->y2 = n > 1 ? _out[n - 2] : yPrev;
+        this->y1 = _out[n - 1];
+        this->y0 = _out[n - 1];
+      }
+
       /// \brief Input gain control coefficients.
       protected: double a0 = 0,
                         a1 = 0,
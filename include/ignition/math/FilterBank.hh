@@ -0,0 +1,433 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_FILTERBANK_HH_
+#define IGNITION_MATH_FILTERBANK_HH_
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class OnePoleBank FilterBank.hh ignition/math/FilterBank.hh
+    /// \brief A bank of one-pole filters, one per channel.
+    ///
+    /// This computes the same output as one OnePole<T> per channel, but the
+    /// coefficients and outputs of all channels are stored in separate
+    /// contiguous arrays (structure of arrays), so a frame with one sample
+    /// per channel is filtered by a single loop that the compiler can
+    /// vectorize. The coefficients can be shared by all channels or set
+    /// per channel.
+    /// \sa OnePole
+    template<typename T>
+    class OnePoleBank
+    {
+      static_assert(std::is_floating_point<T>::value,
+          "OnePoleBank requires a floating point type");
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      public: explicit OnePoleBank(size_t _channels = 0)
+        : a0(_channels, 0), b1(_channels, 0), y0(_channels, 0)
+      {
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _fc Cutoff frequency of all channels.
+      /// \param[in] _fs Sample rate.
+      public: OnePoleBank(size_t _channels, double _fc, double _fs)
+        : OnePoleBank(_channels)
+      {
+        this->Fc(_fc, _fs);
+      }
+
+      /// \brief Get the number of channels.
+      /// \return Number of channels.
+      public: size_t Channels() const
+      {
+        return this->y0.size();
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of all channels.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: void Fc(double _fc, double _fs)
+      {
+        for (size_t i = 0; i < this->Channels(); ++i)
+          this->ChannelFc(i, _fc, _fs);
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of one channel.
+      /// \param[in] _channel Channel index.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: void ChannelFc(size_t _channel, double _fc, double _fs)
+      {
+        const double b = std::exp(-2.0 * IGN_PI * _fc / _fs);
+        this->b1[_channel] = static_cast<T>(b);
+        this->a0[_channel] = static_cast<T>(1.0 - b);
+      }
+
+      /// \brief Set the output of all channels.
+      /// \param[in] _val New value.
+      public: void Set(const T &_val)
+      {
+        this->y0.assign(this->y0.size(), _val);
+      }
+
+      /// \brief Set the output of one channel.
+      /// \param[in] _channel Channel index.
+      /// \param[in] _val New value.
+      public: void Set(size_t _channel, const T &_val)
+      {
+        this->y0[_channel] = _val;
+      }
+
+      /// \brief Get the output of all channels.
+      /// \return Output of each channel.
+      public: const std::vector<T> &Value() const
+      {
+        return this->y0;
+      }
+
+      /// \brief Update the output of all channels with one frame.
+      /// \param[in] _x Input frame, with one sample per channel. Its size
+      /// must be Channels().
+      /// \return Output of each channel.
+      public: const std::vector<T> &Process(const std::vector<T> &_x)
+      {
+        const size_t channels = this->Channels();
+        const T *x = _x.data();
+        const T *a = this->a0.data();
+        const T *b = this->b1.data();
+        T *y = this->y0.data();
+        for (size_t i = 0; i < channels; ++i)
+          y[i] = a[i] * x[i] + b[i] * y[i];
+        return this->y0;
+      }
+
+      /// \brief Input gain control of each channel.
+      protected: std::vector<T> a0;
+
+      /// \brief Gain of the feedback of each channel.
+      protected: std::vector<T> b1;
+
+      /// \brief Output of each channel.
+      protected: std::vector<T> y0;
+    };
+
+    /// \class BiQuadBank FilterBank.hh ignition/math/FilterBank.hh
+    /// \brief A bank of bi-quad filters, one per channel.
+    ///
+    /// This computes the same output as one BiQuad<T> per channel with
+    /// coefficients and state stored as a structure of arrays. Each channel
+    /// is implemented in transposed direct form II, which only needs two
+    /// state variables per channel.
+    /// \sa BiQuad
+    template<typename T>
+    class BiQuadBank
+    {
+      static_assert(std::is_floating_point<T>::value,
+          "BiQuadBank requires a floating point type");
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      public: explicit BiQuadBank(size_t _channels = 0)
+        : a0(_channels, 0), a1(_channels, 0), a2(_channels, 0),
+          b1(_channels, 0), b2(_channels, 0),
+          s1(_channels, 0), s2(_channels, 0), y0(_channels, 0)
+      {
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _fc Cutoff frequency of all channels.
+      /// \param[in] _fs Sample rate.
+      public: BiQuadBank(size_t _channels, double _fc, double _fs)
+        : BiQuadBank(_channels)
+      {
+        this->Fc(_fc, _fs);
+      }
+
+      /// \brief Get the number of channels.
+      /// \return Number of channels.
+      public: size_t Channels() const
+      {
+        return this->y0.size();
+      }
+
+      /// \brief Set the cutoff frequency and sample rate of all channels.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      public: void Fc(double _fc, double _fs, double _q = 0.5)
+      {
+        for (size_t i = 0; i < this->Channels(); ++i)
+          this->ChannelFc(i, _fc, _fs, _q);
+      }
+
+      /// \brief Set the cutoff frequency, sample rate and Q coefficient of
+      /// one channel, with the same low-pass design as BiQuad::Fc.
+      /// \param[in] _channel Channel index.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      /// \param[in] _q Q coefficient.
+      public: void ChannelFc(size_t _channel, double _fc, double _fs,
+                  double _q = 0.5)
+      {
+        const double k = std::tan(IGN_PI * _fc / _fs);
+        const double kQuadDenom = k * k + k / _q + 1.0;
+        const double gain = k * k / kQuadDenom;
+        this->Coefficients(_channel, gain, 2 * gain, gain,
+            2 * (k * k - 1.0) / kQuadDenom,
+            (k * k - k / _q + 1.0) / kQuadDenom);
+      }
+
+      /// \brief Set the coefficients of one channel directly. The transfer
+      /// function is
+      /// \f$H(z) = (a_0 + a_1 z^{-1} + a_2 z^{-2}) /
+      /// (1 + b_1 z^{-1} + b_2 z^{-2})\f$.
+      /// This does not change the state of the channel.
+      /// \param[in] _channel Channel index.
+      /// \param[in] _a0 Input gain coefficient.
+      /// \param[in] _a1 Input gain coefficient of the previous input.
+      /// \param[in] _a2 Input gain coefficient of the input before that.
+      /// \param[in] _b1 Feedback coefficient of the previous output.
+      /// \param[in] _b2 Feedback coefficient of the output before that.
+      public: void Coefficients(size_t _channel, double _a0, double _a1,
+                  double _a2, double _b1, double _b2)
+      {
+        this->a0[_channel] = static_cast<T>(_a0);
+        this->a1[_channel] = static_cast<T>(_a1);
+        this->a2[_channel] = static_cast<T>(_a2);
+        this->b1[_channel] = static_cast<T>(_b1);
+        this->b2[_channel] = static_cast<T>(_b2);
+      }
+
+      /// \brief Set the current output of all channels, as if the input
+      /// and output had been constant at this value.
+      /// \param[in] _val New output.
+      public: void Set(const T &_val)
+      {
+        for (size_t i = 0; i < this->Channels(); ++i)
+          this->Set(i, _val);
+      }
+
+      /// \brief Set the current output of one channel, as if the input and
+      /// output had been constant at this value.
+      /// \param[in] _channel Channel index.
+      /// \param[in] _val New output.
+      public: void Set(size_t _channel, const T &_val)
+      {
+        // Same as BiQuad::Set, which sets the previous inputs and outputs
+        // to _val, expressed with the transposed direct form II state.
+        const size_t i = _channel;
+        this->s1[i] = (this->a1[i] + this->a2[i] - this->b1[i] -
+            this->b2[i]) * _val;
+        this->s2[i] = (this->a2[i] - this->b2[i]) * _val;
+        this->y0[i] = _val;
+      }
+
+      /// \brief Get the output of all channels.
+      /// \return Output of each channel.
+      public: const std::vector<T> &Value() const
+      {
+        return this->y0;
+      }
+
+      /// \brief Update the output of all channels with one frame.
+      /// \param[in] _x Input frame, with one sample per channel. Its size
+      /// must be Channels().
+      /// \return Output of each channel.
+      public: const std::vector<T> &Process(const std::vector<T> &_x)
+      {
+        this->Process(_x.data(), this->y0.data());
+        return this->y0;
+      }
+
+      /// \brief Filter one frame. This is the kernel shared with
+      /// BiQuadCascadeBank.
+      /// \param[in] _x Input frame with Channels() samples.
+      /// \param[out] _y Output frame with Channels() samples. It may be the
+      /// same as _x.
+      protected: void Process(const T *_x, T *_y)
+      {
+        const size_t channels = this->Channels();
+        const T *c0 = this->a0.data();
+        const T *c1 = this->a1.data();
+        const T *c2 = this->a2.data();
+        const T *d1 = this->b1.data();
+        const T *d2 = this->b2.data();
+        T *z1 = this->s1.data();
+        T *z2 = this->s2.data();
+        for (size_t i = 0; i < channels; ++i)
+        {
+          const T x = _x[i];
+          const T y = c0[i] * x + z1[i];
+          z1[i] = c1[i] * x - d1[i] * y + z2[i];
+          z2[i] = c2[i] * x - d2[i] * y;
+          _y[i] = y;
+        }
+      }
+
+      /// \brief Input gain control coefficients of each channel.
+      protected: std::vector<T> a0, a1, a2;
+
+      /// \brief Gain of the feedback coefficients of each channel.
+      protected: std::vector<T> b1, b2;
+
+      /// \brief Transposed direct form II state of each channel.
+      protected: std::vector<T> s1, s2;
+
+      /// \brief Output of each channel.
+      protected: std::vector<T> y0;
+
+      /// \brief Allow cascades to use the frame kernel.
+      template<typename> friend class BiQuadCascadeBank;
+    };
+
+    /// \class BiQuadCascadeBank FilterBank.hh ignition/math/FilterBank.hh
+    /// \brief A bank of filters made of cascaded second-order sections,
+    /// one per channel.
+    ///
+    /// Each section is a BiQuadBank, so higher-order filters reuse the
+    /// same vectorizable kernel. Butterworth() designs a low-pass
+    /// Butterworth filter of any order.
+    template<typename T>
+    class BiQuadCascadeBank
+    {
+      static_assert(std::is_floating_point<T>::value,
+          "BiQuadCascadeBank requires a floating point type");
+
+      /// \brief Constructor.
+      /// \param[in] _channels Number of channels.
+      /// \param[in] _sections Number of second-order sections.
+      public: explicit BiQuadCascadeBank(size_t _channels = 0,
+                  size_t _sections = 0)
+        : sections(_sections, BiQuadBank<T>(_channels)), y0(_channels, 0)
+      {
+      }
+
+      /// \brief Get the number of channels.
+      /// \return Number of channels.
+      public: size_t Channels() const
+      {
+        return this->y0.size();
+      }
+
+      /// \brief Get the second-order sections. Use this to set the
+      /// coefficients of each section.
+      /// \return The sections, in processing order.
+      public: std::vector<BiQuadBank<T>> &Sections()
+      {
+        return this->sections;
+      }
+
+      /// \brief Get the second-order sections.
+      /// \return The sections, in processing order.
+      public: const std::vector<BiQuadBank<T>> &Sections() const
+      {
+        return this->sections;
+      }
+
+      /// \brief Design a low-pass Butterworth filter for all channels. This
+      /// replaces the sections with ceil(_order / 2) sections. For an odd
+      /// order, the last section is a first-order low-pass filter.
+      /// \param[in] _order Order of the filter, at least one.
+      /// \param[in] _fc Cutoff frequency.
+      /// \param[in] _fs Sample rate.
+      public: void Butterworth(unsigned int _order, double _fc, double _fs)
+      {
+        const size_t channels = this->Channels();
+        this->sections.assign((_order + 1) / 2, BiQuadBank<T>(channels));
+
+        // Each pair of complex conjugate poles becomes a section with
+        // Q = 1 / (2 sin((2k + 1) pi / (2n))).
+        for (unsigned int k = 0; k < _order / 2; ++k)
+        {
+          const double q =
+            1.0 / (2.0 * std::sin((2 * k + 1) * IGN_PI / (2.0 * _order)));
+          this->sections[k].Fc(_fc, _fs, q);
+        }
+
+        // The real pole of an odd order filter, with the bilinear transform
+        if (_order % 2 == 1)
+        {
+          const double k = std::tan(IGN_PI * _fc / _fs);
+          const double gain = k / (k + 1.0);
+          for (size_t i = 0; i < channels; ++i)
+          {
+            this->sections.back().Coefficients(i, gain, gain, 0.0,
+                (k - 1.0) / (k + 1.0), 0.0);
+          }
+        }
+      }
+
+      /// \brief Set the current output of all channels, as if the input
+      /// and output had been constant at this value. This assumes each
+      /// section has unity gain at DC, as low-pass designs do.
+      /// \param[in] _val New output.
+      public: void Set(const T &_val)
+      {
+        for (auto &section : this->sections)
+          section.Set(_val);
+        this->y0.assign(this->y0.size(), _val);
+      }
+
+      /// \brief Get the output of all channels.
+      /// \return Output of each channel.
+      public: const std::vector<T> &Value() const
+      {
+        return this->y0;
+      }
+
+      /// \brief Update the output of all channels with one frame.
+      /// \param[in] _x Input frame, with one sample per channel. Its size
+      /// must be Channels().
+      /// \return Output of each channel.
+      public: const std::vector<T> &Process(const std::vector<T> &_x)
+      {
+        const T *x = _x.data();
+        for (auto &section : this->sections)
+        {
+          section.Process(x, this->y0.data());
+          x = this->y0.data();
+        }
+        if (this->sections.empty())
+          this->y0 = _x;
+        return this->y0;
+      }
+
+      /// \brief Second-order sections, in processing order.
+      private: std::vector<BiQuadBank<T>> sections;
+
+      /// \brief Output of each channel.
+      private: std::vector<T> y0;
+    };
+    }
+  }
+}
+
+#endif
@@ -34,6 +34,7 @@ namespace ignition
     //
     // Forward declarations.
     class GaussMarkovProcessPrivate;
+    class RandomGenerator;
 
     /** \class GaussMarkovProcess GaussMarkovProcess.hh\
      * ignition/math/GaussMarkovProcess.hh
@@ -135,6 +136,24 @@ namespace ignition
 
       public: double Update(double _dt);
 
+      /// \brief Update the process with noise from a given generator
+      /// instead of Rand. Giving each process its own generator makes its
+      /// sequence reproducible and independent of other threads.
+      /// \param[in] _dt Length of the timestep after which a new sample
+      /// should be taken.
+      /// \param[in] _generator Random generator used for the noise.
+      /// \return The new value of this process.
+      /// \sa Update(const clock::duration &)
+      public: double Update(const clock::duration &_dt,
+                  RandomGenerator &_generator);
+
+      /// \brief Update the process with noise from a given generator.
+      /// \param[in] _dt Length of the timestep in seconds.
+      /// \param[in] _generator Random generator used for the noise.
+      /// \return The new value of this process.
+      /// \sa Update(const clock::duration &, RandomGenerator &)
+      public: double Update(double _dt, RandomGenerator &_generator);
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
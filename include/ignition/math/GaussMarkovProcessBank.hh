@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_GAUSSMARKOVPROCESSBANK_HH_
+#define IGNITION_MATH_GAUSSMARKOVPROCESSBANK_HH_
+
+#include <memory>
+#include <vector>
+#include <ignition/math/GaussMarkovProcess.hh>
+#include <ignition/math/Export.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declarations.
+    class GaussMarkovProcessBankPrivate;
+    class RandomGenerator;
+
+    /// \class GaussMarkovProcessBank GaussMarkovProcessBank.hh
+    /// ignition/math/GaussMarkovProcessBank.hh
+    /// \brief A bank of independent Ornstein-Uhlenbeck processes, such as
+    /// the bias of every axis of many sensors, advanced together.
+    ///
+    /// Each process follows
+    /// \f$dx = \theta (\mu - x) dt + \sigma dW\f$, where W is a standard
+    /// Wiener process. Update uses the exact discretization of this
+    /// equation,
+    ///
+    /// \f$x_{t+dt} = \mu + (x_t - \mu) e^{-\theta dt} +
+    /// \sigma \sqrt{(1 - e^{-2 \theta dt}) / (2 \theta)} N(0, 1)\f$,
+    ///
+    /// which is stable and has the right variance for any time step, and
+    /// becomes a random walk with variance \f$\sigma^2 dt\f$ when theta is
+    /// zero. Note that GaussMarkovProcess instead adds \f$\sigma N(0, 1)\f$
+    /// at every step, whatever the time step.
+    ///
+    /// Parameters and values are stored as a structure of arrays. The
+    /// decay and noise scale of each process are cached for the last time
+    /// step, and the normal values of one Update are drawn with a single
+    /// bulk fill, so an Update with a constant time step is a single loop
+    /// over all processes.
+    class IGNITION_MATH_VISIBLE GaussMarkovProcessBank
+    {
+      /// \brief Constructor of an empty bank.
+      public: GaussMarkovProcessBank();
+
+      /// \brief Destructor.
+      public: ~GaussMarkovProcessBank();
+
+      /// \brief Get the number of processes.
+      /// \return Number of processes.
+      public: size_t Count() const;
+
+      /// \brief Add a process.
+      /// \param[in] _start The start value of the process.
+      /// \param[in] _theta The theta parameter. A value of zero will be
+      /// used if this parameter is negative.
+      /// \param[in] _mu The mu parameter.
+      /// \param[in] _sigma The sigma parameter. A value of zero will be
+      /// used if this parameter is negative.
+      /// \return Index of the new process.
+      public: size_t AddProcess(double _start, double _theta, double _mu,
+                  double _sigma);
+
+      /// \brief Set the parameters of a process and reset it to its start
+      /// value.
+      /// \param[in] _index Index of the process.
+      /// \param[in] _start The start value of the process.
+      /// \param[in] _theta The theta parameter.
+      /// \param[in] _mu The mu parameter.
+      /// \param[in] _sigma The sigma parameter.
+      /// \return False if _index is out of range.
+      public: bool Set(size_t _index, double _start, double _theta,
+                  double _mu, double _sigma);
+
+      /// \brief Remove a process. The last process is moved to its index.
+      /// \param[in] _index Index of the process.
+      /// \return False if _index is out of range.
+      public: bool RemoveProcess(size_t _index);
+
+      /// \brief Remove all processes.
+      public: void Clear();
+
+      /// \brief Reset all processes to their start values.
+      public: void Reset();
+
+      /// \brief Get the start value of a process.
+      /// \param[in] _index Index of the process.
+      /// \return Start value, or NaN if _index is out of range.
+      public: double Start(size_t _index) const;
+
+      /// \brief Get the theta value of a process.
+      /// \param[in] _index Index of the process.
+      /// \return Theta, or NaN if _index is out of range.
+      public: double Theta(size_t _index) const;
+
+      /// \brief Get the mu value of a process.
+      /// \param[in] _index Index of the process.
+      /// \return Mu, or NaN if _index is out of range.
+      public: double Mu(size_t _index) const;
+
+      /// \brief Get the sigma value of a process.
+      /// \param[in] _index Index of the process.
+      /// \return Sigma, or NaN if _index is out of range.
+      public: double Sigma(size_t _index) const;
+
+      /// \brief Get the current value of a process.
+      /// \param[in] _index Index of the process.
+      /// \return Value, or NaN if _index is out of range.
+      public: double Value(size_t _index) const;
+
+      /// \brief Get the current values of all processes.
+      /// \return Values, in process order.
+      public: const std::vector<double> &Values() const;
+
+      /// \brief Advance all processes, with noise from the generator of
+      /// the calling thread used by Rand.
+      /// \param[in] _dt Time step. Processes do not change if it is not
+      /// positive.
+      /// \return The new values.
+      public: const std::vector<double> &Update(const clock::duration &_dt);
+
+      /// \brief Advance all processes, with noise from the generator of
+      /// the calling thread used by Rand.
+      /// \param[in] _dt Time step in seconds. Processes do not change if
+      /// it is not positive.
+      /// \return The new values.
+      public: const std::vector<double> &Update(double _dt);
+
+      /// \brief Advance all processes, with noise from a given generator.
+      /// \param[in] _dt Time step. Processes do not change if it is not
+      /// positive.
+      /// \param[in] _generator Random generator used for the noise.
+      /// \return The new values.
+      public: const std::vector<double> &Update(const clock::duration &_dt,
+                  RandomGenerator &_generator);
+
+      /// \brief Advance all processes, with noise from a given generator.
+      /// \param[in] _dt Time step in seconds. Processes do not change if
+      /// it is not positive.
+      /// \param[in] _generator Random generator used for the noise.
+      /// \return The new values.
+      public: const std::vector<double> &Update(double _dt,
+                  RandomGenerator &_generator);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<GaussMarkovProcessBankPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
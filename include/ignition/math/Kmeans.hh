@@ -17,6 +17,7 @@
 #ifndef IGNITION_MATH_KMEANS_HH_
 #define IGNITION_MATH_KMEANS_HH_
 
+#include <cstddef>
 #include <vector>
 #include <ignition/math/Vector3.hh>
 #include <ignition/math/Helpers.hh>
@@ -37,8 +38,28 @@ namespace ignition
     /// k-means partitions the observations into k sets so as to minimize the
     /// within-cluster sum of squares.
     /// Description based on http://en.wikipedia.org/wiki/K-means_clustering.
+    ///
+    /// Initial centroids are chosen with k-means++ (Arthur and Vassilvitskii,
+    /// 2007), which spreads them over the data, using a generator seeded
+    /// with Seed() so results are reproducible. Iterations use the bounds of
+    /// Hamerly, "Making k-means even faster", 2010, to skip most distance
+    /// computations once the clusters settle.
+    ///
+    /// Cluster can run on several threads, see Threads(unsigned int).
+    /// Observations are split into chunks that only depend on their
+    /// number, and the partial sums of the chunks are merged in order, so
+    /// results are identical for any number of threads.
+    ///
+    /// Large sets of points can be clustered without copies with the
+    /// Cluster overloads that take a pointer to caller-owned points, for
+    /// instance the points of a memory-mapped file, in double or float
+    /// precision and as an array of points or one array per coordinate.
     class IGNITION_MATH_VISIBLE Kmeans
     {
+      /// \brief Constructor without observations, for the Cluster
+      /// overloads that take caller-owned points.
+      public: Kmeans();
+
       /// \brief constructor
       /// \param[in] _obs Set of observations to cluster.
       public: explicit Kmeans(const std::vector<Vector3d> &_obs);
@@ -60,6 +81,25 @@ namespace ignition
       /// \return True if the _obs vector is not empty or false otherwise.
       public: bool AppendObservations(const std::vector<Vector3d> &_obs);
 
+      /// \brief Set the seed used to choose the initial centroids. The
+      /// default seed is zero.
+      /// \param[in] _seed Seed.
+      public: void Seed(unsigned int _seed);
+
+      /// \brief Get the seed used to choose the initial centroids.
+      /// \return Seed.
+      public: unsigned int Seed() const;
+
+      /// \brief Set the number of threads used by Cluster. The default is
+      /// one.
+      /// \param[in] _threads Number of threads, or zero to use one per
+      /// hardware thread.
+      public: void Threads(unsigned int _threads);
+
+      /// \brief Get the number of threads used by Cluster.
+      /// \return Number of threads.
+      public: unsigned int Threads() const;
+
       /// \brief Executes the k-means algorithm.
       /// \param[in] _k Number of partitions to cluster.
       /// \param[out] _centroids Vector of centroids. Each element contains the
@@ -75,6 +115,66 @@ namespace ignition
                            std::vector<Vector3d> &_centroids,
                            std::vector<unsigned int> &_labels);
 
+      /// \brief Executes the k-means algorithm on caller-owned points,
+      /// which are neither copied nor stored. The observations of this
+      /// object are not used.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[in] _k Number of partitions to cluster.
+      /// \param[out] _centroids Vector of centroids.
+      /// \param[out] _labels Array of _count labels, one per point.
+      /// \return False if a pointer is null, if the number of clusters is
+      /// not positive or if it is greater than the number of points.
+      public: bool Cluster(const Vector3d *_points, size_t _count, int _k,
+                           std::vector<Vector3d> &_centroids,
+                           unsigned int *_labels);
+
+      /// \brief Executes the k-means algorithm on caller-owned points in
+      /// single precision. Centroids are computed in double precision.
+      /// \param[in] _points Array of _count points.
+      /// \param[in] _count Number of points.
+      /// \param[in] _k Number of partitions to cluster.
+      /// \param[out] _centroids Vector of centroids.
+      /// \param[out] _labels Array of _count labels, one per point.
+      /// \return False if a pointer is null, if the number of clusters is
+      /// not positive or if it is greater than the number of points.
+      public: bool Cluster(const Vector3f *_points, size_t _count, int _k,
+                           std::vector<Vector3d> &_centroids,
+                           unsigned int *_labels);
+
+      /// \brief Executes the k-means algorithm on caller-owned points
+      /// stored as one array per coordinate.
+      /// \param[in] _x Array of _count X coordinates.
+      /// \param[in] _y Array of _count Y coordinates.
+      /// \param[in] _z Array of _count Z coordinates.
+      /// \param[in] _count Number of points.
+      /// \param[in] _k Number of partitions to cluster.
+      /// \param[out] _centroids Vector of centroids.
+      /// \param[out] _labels Array of _count labels, one per point.
+      /// \return False if a pointer is null, if the number of clusters is
+      /// not positive or if it is greater than the number of points.
+      public: bool Cluster(const double *_x, const double *_y,
+                           const double *_z, size_t _count, int _k,
+                           std::vector<Vector3d> &_centroids,
+                           unsigned int *_labels);
+
+      /// \brief Executes the k-means algorithm on caller-owned points
+      /// stored as one array per coordinate in single precision. Centroids
+      /// are computed in double precision.
+      /// \param[in] _x Array of _count X coordinates.
+      /// \param[in] _y Array of _count Y coordinates.
+      /// \param[in] _z Array of _count Z coordinates.
+      /// \param[in] _count Number of points.
+      /// \param[in] _k Number of partitions to cluster.
+      /// \param[out] _centroids Vector of centroids.
+      /// \param[out] _labels Array of _count labels, one per point.
+      /// \return False if a pointer is null, if the number of clusters is
+      /// not positive or if it is greater than the number of points.
+      public: bool Cluster(const float *_x, const float *_y,
+                           const float *_z, size_t _count, int _k,
+                           std::vector<Vector3d> &_centroids,
+                           unsigned int *_labels);
+
       /// \brief Given an observation, it returns the closest centroid to it.
       /// \param[in] _p Point to check.
       /// \return The index of the closest centroid to the point _p.
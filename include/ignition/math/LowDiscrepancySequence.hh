@@ -0,0 +1,383 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_LOWDISCREPANCYSEQUENCE_HH_
+#define IGNITION_MATH_LOWDISCREPANCYSEQUENCE_HH_
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class SobolSequence LowDiscrepancySequence.hh
+    /// ignition/math/LowDiscrepancySequence.hh
+    /// \brief Sobol low-discrepancy sequence in 1 to 6 dimensions, with
+    /// optional Owen scrambling.
+    ///
+    /// Points of a low-discrepancy sequence fill the unit cube much more
+    /// evenly than independent uniform samples, so Monte Carlo estimates
+    /// such as integrals converge close to O(1/N) instead of O(1/sqrt(N)).
+    /// The first 2^k points of each dimension fall one in each interval
+    /// [j / 2^k, (j + 1) / 2^k).
+    ///
+    /// Direction numbers are those of Joe and Kuo, "Constructing Sobol
+    /// sequences with better two-dimensional projections", 2008, and
+    /// points are generated in Gray code order. Scrambling uses the
+    /// hash-based nested uniform scrambling of Burley, "Practical
+    /// Hash-based Owen Scrambling", 2020: it keeps the stratification
+    /// properties, makes every point uniformly distributed, and gives
+    /// independent randomizations for different seeds. The sequence has
+    /// 2^32 points.
+    class SobolSequence
+    {
+      /// \brief Largest number of dimensions.
+      public: static constexpr unsigned int kMaxDimensions = 6;
+
+      /// \brief Constructor of an unscrambled sequence.
+      /// \param[in] _dimensions Number of dimensions, clamped to [1, 6].
+      public: explicit SobolSequence(unsigned int _dimensions = 1)
+        : dimensions(std::min(std::max(_dimensions, 1u), kMaxDimensions))
+      {
+        this->Init();
+      }
+
+      /// \brief Constructor of an Owen scrambled sequence.
+      /// \param[in] _dimensions Number of dimensions, clamped to [1, 6].
+      /// \param[in] _seed Scrambling seed.
+      public: SobolSequence(unsigned int _dimensions, uint32_t _seed)
+        : dimensions(std::min(std::max(_dimensions, 1u), kMaxDimensions)),
+          scrambled(true)
+      {
+        this->Init();
+        for (unsigned int d = 0; d < kMaxDimensions; ++d)
+          this->seeds[d] = Hash(_seed ^ Hash(d + 1));
+      }
+
+      /// \brief Get the number of dimensions.
+      /// \return Number of dimensions.
+      public: unsigned int Dimensions() const
+      {
+        return this->dimensions;
+      }
+
+      /// \brief Get whether the sequence is scrambled.
+      /// \return True if the sequence is Owen scrambled.
+      public: bool Scrambled() const
+      {
+        return this->scrambled;
+      }
+
+      /// \brief Get the index of the next point returned by Fill.
+      /// \return Index.
+      public: uint32_t Index() const
+      {
+        return this->index;
+      }
+
+      /// \brief Set the index of the next point returned by Fill.
+      /// \param[in] _index Index.
+      public: void SetIndex(uint32_t _index)
+      {
+        this->index = _index;
+        const uint32_t gray = _index ^ (_index >> 1);
+        for (unsigned int d = 0; d < this->dimensions; ++d)
+          this->state[d] = this->Bits(gray, d);
+      }
+
+      /// \brief Skip points.
+      /// \param[in] _count Number of points to skip.
+      public: void Skip(uint32_t _count)
+      {
+        this->SetIndex(this->index + _count);
+      }
+
+      /// \brief Compute one coordinate of a point directly. This does not
+      /// change the index.
+      /// \param[in] _index Index of the point.
+      /// \param[in] _dim Dimension, less than Dimensions().
+      /// \return Coordinate in [0, 1), or 0 if _dim is out of range.
+      public: double Sample(uint32_t _index, unsigned int _dim) const
+      {
+        if (_dim >= this->dimensions)
+          return 0.0;
+        return this->ToDouble(this->Bits(_index ^ (_index >> 1), _dim),
+            _dim);
+      }
+
+      /// \brief Write consecutive points, starting at Index(), and advance
+      /// the index past them.
+      /// \param[in,out] _points Interleaved coordinates of the points to
+      /// overwrite. The size is kept and must be a multiple of
+      /// Dimensions().
+      /// \return False if the size is not a multiple of Dimensions().
+      public: bool Fill(std::vector<double> &_points)
+      {
+        if (_points.size() % this->dimensions != 0)
+          return false;
+
+        const unsigned int dims = this->dimensions;
+        for (size_t i = 0; i < _points.size(); i += dims)
+        {
+          for (unsigned int d = 0; d < dims; ++d)
+            _points[i + d] = this->ToDouble(this->state[d], d);
+
+          // In Gray code order, the next point differs by one direction
+          // number, selected by the lowest set bit of the next index.
+          ++this->index;
+          if (this->index == 0)
+          {
+            this->SetIndex(0);
+            continue;
+          }
+          unsigned int bit = 0;
+          while (!(this->index & (1u << bit)))
+            ++bit;
+          for (unsigned int d = 0; d < dims; ++d)
+            this->state[d] ^= this->directions[d][bit];
+        }
+        return true;
+      }
+
+      /// \brief Compute the direction numbers.
+      private: void Init()
+      {
+        // Degree, coefficients and initial numbers of the primitive
+        // polynomials of dimensions 2 to 6, from the new-joe-kuo-6.21201
+        // file.
+        static const unsigned int kDegree[] = {1, 2, 3, 3, 4};
+        static const unsigned int kCoeffs[] = {0, 1, 1, 2, 1};
+        static const uint32_t kInitial[][4] = {
+          {1, 0, 0, 0}, {1, 3, 0, 0}, {1, 3, 1, 0}, {1, 1, 1, 0},
+          {1, 1, 3, 3}};
+
+        // The first dimension is the van der Corput sequence
+        for (unsigned int i = 0; i < 32; ++i)
+          this->directions[0][i] = 1u << (31 - i);
+
+        for (unsigned int d = 1; d < kMaxDimensions; ++d)
+        {
+          const unsigned int s = kDegree[d - 1];
+          const unsigned int a = kCoeffs[d - 1];
+          uint32_t *v = this->directions[d];
+          for (unsigned int i = 0; i < s; ++i)
+            v[i] = kInitial[d - 1][i] << (31 - i);
+          for (unsigned int i = s; i < 32; ++i)
+          {
+            v[i] = v[i - s] ^ (v[i - s] >> s);
+            for (unsigned int k = 1; k < s; ++k)
+            {
+              if ((a >> (s - 1 - k)) & 1)
+                v[i] ^= v[i - k];
+            }
+          }
+        }
+        this->SetIndex(0);
+      }
+
+      /// \brief Compute the unscrambled bits of a coordinate.
+      /// \param[in] _gray Gray code of the point index.
+      /// \param[in] _dim Dimension.
+      /// \return Coordinate scaled by 2^32.
+      private: uint32_t Bits(uint32_t _gray, unsigned int _dim) const
+      {
+        uint32_t result = 0;
+        for (unsigned int bit = 0; _gray; ++bit, _gray >>= 1)
+        {
+          if (_gray & 1)
+            result ^= this->directions[_dim][bit];
+        }
+        return result;
+      }
+
+      /// \brief Scramble a coordinate if needed and convert it to double.
+      /// \param[in] _bits Unscrambled coordinate scaled by 2^32.
+      /// \param[in] _dim Dimension.
+      /// \return Coordinate in [0, 1).
+      private: double ToDouble(uint32_t _bits, unsigned int _dim) const
+      {
+        if (this->scrambled)
+          _bits = ReverseBits(LaineKarras(ReverseBits(_bits),
+                this->seeds[_dim]));
+        return static_cast<double>(_bits) * 0x1.0p-32;
+      }
+
+      /// \brief Laine-Karras style permutation of Burley, in which each
+      /// bit only depends on the bits below it. Applied to reversed bits,
+      /// it is a nested uniform scramble.
+      /// \param[in] _x Reversed coordinate bits.
+      /// \param[in] _seed Seed.
+      /// \return Permuted bits.
+      private: static uint32_t LaineKarras(uint32_t _x, uint32_t _seed)
+      {
+        _x ^= _x * 0x3d20adeau;
+        _x += _seed;
+        _x *= (_seed >> 16) | 1u;
+        _x ^= _x * 0x05526c56u;
+        _x ^= _x * 0x53a22864u;
+        return _x;
+      }
+
+      /// \brief Reverse the order of bits.
+      /// \param[in] _x Value.
+      /// \return Reversed value.
+      private: static uint32_t ReverseBits(uint32_t _x)
+      {
+        _x = ((_x >> 1) & 0x55555555u) | ((_x & 0x55555555u) << 1);
+        _x = ((_x >> 2) & 0x33333333u) | ((_x & 0x33333333u) << 2);
+        _x = ((_x >> 4) & 0x0f0f0f0fu) | ((_x & 0x0f0f0f0fu) << 4);
+        _x = ((_x >> 8) & 0x00ff00ffu) | ((_x & 0x00ff00ffu) << 8);
+        return (_x >> 16) | (_x << 16);
+      }
+
+      /// \brief Integer hash used to derive a seed for each dimension.
+      /// \param[in] _x Value.
+      /// \return Hashed value.
+      private: static uint32_t Hash(uint32_t _x)
+      {
+        _x ^= _x >> 16;
+        _x *= 0x7feb352du;
+        _x ^= _x >> 15;
+        _x *= 0x846ca68bu;
+        _x ^= _x >> 16;
+        return _x;
+      }
+
+      /// \brief Number of dimensions.
+      private: unsigned int dimensions;
+
+      /// \brief True if the sequence is Owen scrambled.
+      private: bool scrambled = false;
+
+      /// \brief Index of the next point returned by Fill.
+      private: uint32_t index = 0;
+
+      /// \brief Direction numbers of each dimension, scaled by 2^32.
+      private: uint32_t directions[kMaxDimensions][32];
+
+      /// \brief Unscrambled coordinates of the next point.
+      private: uint32_t state[kMaxDimensions] = {0, 0, 0, 0, 0, 0};
+
+      /// \brief Scrambling seed of each dimension.
+      private: uint32_t seeds[kMaxDimensions] = {0, 0, 0, 0, 0, 0};
+    };
+
+    /// \class HaltonSequence LowDiscrepancySequence.hh
+    /// ignition/math/LowDiscrepancySequence.hh
+    /// \brief Halton low-discrepancy sequence in 1 to 6 dimensions.
+    ///
+    /// Dimension d is the radical inverse of the point index in the d-th
+    /// prime base (2, 3, 5, 7, 11 and 13). Unlike SobolSequence, any
+    /// number of points is evenly distributed, not only powers of two.
+    class HaltonSequence
+    {
+      /// \brief Largest number of dimensions.
+      public: static constexpr unsigned int kMaxDimensions = 6;
+
+      /// \brief Constructor.
+      /// \param[in] _dimensions Number of dimensions, clamped to [1, 6].
+      public: explicit HaltonSequence(unsigned int _dimensions = 1)
+        : dimensions(std::min(std::max(_dimensions, 1u), kMaxDimensions))
+      {
+      }
+
+      /// \brief Get the number of dimensions.
+      /// \return Number of dimensions.
+      public: unsigned int Dimensions() const
+      {
+        return this->dimensions;
+      }
+
+      /// \brief Get the index of the next point returned by Fill.
+      /// \return Index.
+      public: uint64_t Index() const
+      {
+        return this->index;
+      }
+
+      /// \brief Set the index of the next point returned by Fill.
+      /// \param[in] _index Index.
+      public: void SetIndex(uint64_t _index)
+      {
+        this->index = _index;
+      }
+
+      /// \brief Skip points.
+      /// \param[in] _count Number of points to skip.
+      public: void Skip(uint64_t _count)
+      {
+        this->index += _count;
+      }
+
+      /// \brief Compute one coordinate of a point directly.
+      /// \param[in] _index Index of the point.
+      /// \param[in] _dim Dimension, less than Dimensions().
+      /// \return Coordinate in [0, 1), or 0 if _dim is out of range.
+      public: double Sample(uint64_t _index, unsigned int _dim) const
+      {
+        static const uint64_t kBases[] = {2, 3, 5, 7, 11, 13};
+        if (_dim >= this->dimensions)
+          return 0.0;
+
+        const uint64_t base = kBases[_dim];
+        const double invBase = 1.0 / static_cast<double>(base);
+        double scale = invBase;
+        double result = 0.0;
+        for (; _index; _index /= base)
+        {
+          result += static_cast<double>(_index % base) * scale;
+          scale *= invBase;
+        }
+        return result;
+      }
+
+      /// \brief Write consecutive points, starting at Index(), and advance
+      /// the index past them.
+      /// \param[in,out] _points Interleaved coordinates of the points to
+      /// overwrite. The size is kept and must be a multiple of
+      /// Dimensions().
+      /// \return False if the size is not a multiple of Dimensions().
+      public: bool Fill(std::vector<double> &_points)
+      {
+        if (_points.size() % this->dimensions != 0)
+          return false;
+
+        for (size_t i = 0; i < _points.size(); i += this->dimensions)
+        {
+          for (unsigned int d = 0; d < this->dimensions; ++d)
+            _points[i + d] = this->Sample(this->index, d);
+          ++this->index;
+        }
+        return true;
+      }
+
+      /// \brief Number of dimensions.
+      private: unsigned int dimensions;
+
+      /// \brief Index of the next point returned by Fill.
+      private: uint64_t index = 0;
+    };
+    }
+  }
+}
+
+#endif
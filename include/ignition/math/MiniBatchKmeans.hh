@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_MINIBATCHKMEANS_HH_
+#define IGNITION_MATH_MINIBATCHKMEANS_HH_
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class MiniBatchKmeansPrivate;
+
+    /// \class MiniBatchKmeans MiniBatchKmeans.hh
+    /// ignition/math/MiniBatchKmeans.hh
+    /// \brief Mini-batch k-means for observations that arrive over time,
+    /// from Sculley, "Web-Scale K-Means Clustering", 2010.
+    ///
+    /// Unlike Kmeans, observations are not stored: each batch moves the
+    /// centroids and is then forgotten, so memory only depends on the
+    /// number of clusters. Every observation of a batch is first assigned
+    /// to its closest centroid, then each centroid moves towards its
+    /// observations with a learning rate of one over the number of
+    /// observations it has absorbed so far. Each centroid is therefore the
+    /// running mean of its observations, and centroids that have seen
+    /// little data adapt faster.
+    ///
+    /// Centroids are initialized by running Kmeans on the first k
+    /// observations or more, or can be set, for instance to warm start
+    /// from a previous run.
+    class IGNITION_MATH_VISIBLE MiniBatchKmeans
+    {
+      /// \brief Constructor.
+      /// \param[in] _k Number of clusters. Zero is replaced by one.
+      /// \param[in] _seed Seed used to initialize the centroids and to draw
+      /// batches in Fit.
+      public: explicit MiniBatchKmeans(unsigned int _k,
+                  unsigned int _seed = 0);
+
+      /// \brief Destructor.
+      public: ~MiniBatchKmeans();
+
+      /// \brief Get the number of clusters.
+      /// \return Number of clusters.
+      public: unsigned int K() const;
+
+      /// \brief Get whether the centroids are initialized.
+      /// \return True if the centroids are initialized.
+      public: bool Initialized() const;
+
+      /// \brief Get the centroids.
+      /// \return Centroids, or an empty vector if they are not
+      /// initialized.
+      public: const std::vector<Vector3d> &Centroids() const;
+
+      /// \brief Get the number of observations absorbed by each centroid.
+      /// \return Counts, or an empty vector if the centroids are not
+      /// initialized.
+      public: const std::vector<uint64_t> &Counts() const;
+
+      /// \brief Set the centroids, with a count of one each, so that they
+      /// quickly adapt to new observations.
+      /// \param[in] _centroids K() centroids.
+      /// \return False if the number of centroids is not K().
+      public: bool Centroids(const std::vector<Vector3d> &_centroids);
+
+      /// \brief Set the centroids and their counts, for instance to resume
+      /// from a previous run. Larger counts make centroids move less.
+      /// \param[in] _centroids K() centroids.
+      /// \param[in] _counts Number of observations already absorbed by each
+      /// centroid. Zero is replaced by one.
+      /// \return False if the number of centroids or counts is not K().
+      public: bool Centroids(const std::vector<Vector3d> &_centroids,
+                  const std::vector<uint64_t> &_counts);
+
+      /// \brief Forget the centroids.
+      public: void Reset();
+
+      /// \brief Update the centroids with a batch of new observations.
+      /// Before the centroids are initialized, observations are kept until
+      /// there are at least K() of them, and the centroids are then
+      /// initialized by running Kmeans on them.
+      /// \param[in] _batch Observations.
+      /// \return True if the centroids are initialized after the update.
+      public: bool Update(const std::vector<Vector3d> &_batch);
+
+      /// \brief Cluster a set of observations with random batches drawn
+      /// with replacement. If the centroids are not initialized, Kmeans is
+      /// first run on a random sample of 3 * max(K(), _batchSize)
+      /// observations.
+      /// \param[in] _obs Observations. They are not copied.
+      /// \param[in] _iterations Number of batches.
+      /// \param[in] _batchSize Number of observations of each batch.
+      /// \return False if there are fewer observations than clusters.
+      public: bool Fit(const std::vector<Vector3d> &_obs,
+                  unsigned int _iterations, unsigned int _batchSize = 1024);
+
+      /// \brief Get the closest centroid to a point.
+      /// \param[in] _p Point.
+      /// \return Index of the closest centroid, or 0 if the centroids are
+      /// not initialized.
+      public: unsigned int Label(const Vector3d &_p) const;
+
+      /// \brief Get the closest centroid to each point.
+      /// \param[in] _points Points.
+      /// \param[out] _labels Index of the closest centroid to each point.
+      /// \return False if the centroids are not initialized.
+      public: bool Labels(const std::vector<Vector3d> &_points,
+                  std::vector<unsigned int> &_labels) const;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<MiniBatchKmeansPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
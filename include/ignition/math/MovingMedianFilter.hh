@@ -0,0 +1,369 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_MOVINGMEDIANFILTER_HH_
+#define IGNITION_MATH_MOVINGMEDIANFILTER_HH_
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class MovingMedianFilter MovingMedianFilter.hh
+    /// ignition/math/MovingMedianFilter.hh
+    /// \brief Median of the most recent values of a signal, which smooths
+    /// the signal while rejecting outliers.
+    ///
+    /// The values in the window are kept in a ring buffer, and their slots
+    /// are ordered by two indexed heaps: a max-heap with the lower half of
+    /// the values and a min-heap with the upper half. When the window is
+    /// full, the new value overwrites the oldest one in place, and only
+    /// that heap entry is moved, so Update takes O(log n) time. All the
+    /// storage is allocated when the window size is set, so Update does
+    /// not allocate.
+    ///
+    /// T must be ordered by operator<. When the window holds an even
+    /// number of values, the median is the mean of the two middle values,
+    /// (a + b) / 2.
+    ///
+    /// The default window size is 5.
+    template<typename T>
+    class MovingMedianFilter
+    {
+      /// \brief Constructor
+      /// \param[in] _windowSize The window size to use. This value will be
+      /// ignored if it is equal to zero, and a window size of 5 is used.
+      public: explicit MovingMedianFilter(unsigned int _windowSize = 5)
+      {
+        this->SetWindowSize(_windowSize > 0 ? _windowSize : 5);
+      }
+
+      /// \brief Update value of filter
+      /// \param[in] _val new raw value
+      public: void Update(const T _val)
+      {
+        const size_t slot = this->next;
+        if (++this->next == this->values.size())
+          this->next = 0;
+
+        if (this->samples < this->values.size())
+        {
+          ++this->samples;
+          this->values[slot] = _val;
+          this->Insert(slot);
+        }
+        else
+        {
+          this->values[slot] = _val;
+          this->Replace(slot);
+        }
+      }
+
+      /// \brief Update the filter with a block of values, such as a
+      /// recorded signal.
+      /// \param[in] _in Raw values, in order.
+      /// \param[out] _out Filtered value after each raw value. It is
+      /// resized to the size of _in, and may be the same vector as _in.
+      public: void Update(const std::vector<T> &_in, std::vector<T> &_out)
+      {
+        _out.resize(_in.size());
+        for (size_t i = 0; i < _in.size(); ++i)
+        {
+          this->Update(_in[i]);
+          _out[i] = this->Value();
+        }
+      }
+
+      /// \brief Set window size. This also clears the history.
+      /// Nothing happens if _n is zero.
+      /// \param[in] _n new desired window size
+      public: void SetWindowSize(const unsigned int _n)
+      {
+        if (_n == 0)
+          return;
+
+        this->values.assign(_n, T());
+        this->heapIndex.assign(_n, 0);
+        this->inLower.assign(_n, false);
+        this->lower.assign(_n / 2 + 1, 0);
+        this->upper.assign(_n / 2 + 1, 0);
+        this->Clear();
+      }
+
+      /// \brief Remove all the values, keeping the window size.
+      public: void Clear()
+      {
+        this->next = 0;
+        this->samples = 0;
+        this->lowerCount = 0;
+        this->upperCount = 0;
+      }
+
+      /// \brief Get the window size.
+      /// \return The size of the moving window.
+      public: unsigned int WindowSize() const
+      {
+        return static_cast<unsigned int>(this->values.size());
+      }
+
+      /// \brief Get whether the window has been filled.
+      /// \return True if the window has been filled.
+      public: bool WindowFilled() const
+      {
+        return this->samples == this->values.size();
+      }
+
+      /// \brief Get the number of values in the window.
+      /// \return Number of values.
+      public: unsigned int Count() const
+      {
+        return static_cast<unsigned int>(this->samples);
+      }
+
+      /// \brief Get filtered result
+      /// \return Median of the values in the window, or T() if there are
+      /// no values.
+      public: T Value() const
+      {
+        if (this->samples == 0)
+          return T();
+
+        const T &low = this->values[this->lower[0]];
+        if (this->lowerCount > this->upperCount)
+          return low;
+        return (low + this->values[this->upper[0]]) / 2;
+      }
+
+      /// \brief Add a value that is not in a heap yet, and balance the
+      /// heaps so the lower half has the same number of values as the
+      /// upper half or one more.
+      /// \param[in] _slot Slot of the value.
+      private: void Insert(size_t _slot)
+      {
+        if (this->lowerCount == 0 ||
+            !(this->values[this->lower[0]] < this->values[_slot]))
+        {
+          this->Push(true, _slot);
+        }
+        else
+        {
+          this->Push(false, _slot);
+        }
+
+        if (this->lowerCount > this->upperCount + 1)
+          this->Push(false, this->Pop(true));
+        else if (this->upperCount > this->lowerCount)
+          this->Push(true, this->Pop(false));
+      }
+
+      /// \brief Restore the heaps after the value of a slot has changed.
+      /// The heap sizes do not change.
+      /// \param[in] _slot Slot of the value.
+      private: void Replace(size_t _slot)
+      {
+        const size_t index = this->heapIndex[_slot];
+        if (this->inLower[_slot])
+        {
+          if (this->upperCount == 0 ||
+              !(this->values[this->upper[0]] < this->values[_slot]))
+          {
+            this->Restore(true, index);
+            return;
+          }
+
+          // The value belongs to the upper half. Exchange it with the
+          // smallest value of the upper half, which is not smaller than
+          // any value left in the lower half.
+          const size_t other = this->upper[0];
+          this->Place(true, index, other);
+          this->Place(false, 0, _slot);
+          this->SiftUp(true, index);
+          this->SiftDown(false, 0);
+        }
+        else
+        {
+          if (!(this->values[_slot] < this->values[this->lower[0]]))
+          {
+            this->Restore(false, index);
+            return;
+          }
+
+          const size_t other = this->lower[0];
+          this->Place(false, index, other);
+          this->Place(true, 0, _slot);
+          this->SiftUp(false, index);
+          this->SiftDown(true, 0);
+        }
+      }
+
+      /// \brief Check whether slot _a must be above slot _b in a heap.
+      /// \param[in] _lower True for the lower half max-heap, false for the
+      /// upper half min-heap.
+      /// \param[in] _a First slot.
+      /// \param[in] _b Second slot.
+      /// \return True if _a must be above _b.
+      private: bool Above(bool _lower, size_t _a, size_t _b) const
+      {
+        return _lower ? this->values[_b] < this->values[_a] :
+                        this->values[_a] < this->values[_b];
+      }
+
+      /// \brief Get a heap.
+      /// \param[in] _lower True for the lower half, false for the upper.
+      /// \return The slots in heap order.
+      private: std::vector<size_t> &Heap(bool _lower)
+      {
+        return _lower ? this->lower : this->upper;
+      }
+
+      /// \brief Get the number of slots in a heap.
+      /// \param[in] _lower True for the lower half, false for the upper.
+      /// \return Reference to the count.
+      private: size_t &HeapCount(bool _lower)
+      {
+        return _lower ? this->lowerCount : this->upperCount;
+      }
+
+      /// \brief Store a slot at a heap position and update its index.
+      /// \param[in] _lower True for the lower half, false for the upper.
+      /// \param[in] _index Position in the heap.
+      /// \param[in] _slot Slot to store.
+      private: void Place(bool _lower, size_t _index, size_t _slot)
+      {
+        this->Heap(_lower)[_index] = _slot;
+        this->heapIndex[_slot] = _index;
+        this->inLower[_slot] = _lower;
+      }
+
+      /// \brief Move a heap entry up until its parent is above it.
+      /// \param[in] _lower True for the lower half, false for the upper.
+      /// \param[in] _index Position in the heap.
+      /// \return Final position.
+      private: size_t SiftUp(bool _lower, size_t _index)
+      {
+        std::vector<size_t> &heap = this->Heap(_lower);
+        const size_t slot = heap[_index];
+        while (_index > 0)
+        {
+          const size_t parent = (_index - 1) / 2;
+          if (!this->Above(_lower, slot, heap[parent]))
+            break;
+          this->Place(_lower, _index, heap[parent]);
+          _index = parent;
+        }
+        this->Place(_lower, _index, slot);
+        return _index;
+      }
+
+      /// \brief Move a heap entry down until it is above its children.
+      /// \param[in] _lower True for the lower half, false for the upper.
+      /// \param[in] _index Position in the heap.
+      private: void SiftDown(bool _lower, size_t _index)
+      {
+        std::vector<size_t> &heap = this->Heap(_lower);
+        const size_t count = this->HeapCount(_lower);
+        const size_t slot = heap[_index];
+        while (true)
+        {
+          size_t child = 2 * _index + 1;
+          if (child >= count)
+            break;
+          if (child + 1 < count &&
+              this->Above(_lower, heap[child + 1], heap[child]))
+          {
+            ++child;
+          }
+          if (!this->Above(_lower, heap[child], slot))
+            break;
+          this->Place(_lower, _index, heap[child]);
+          _index = child;
+        }
+        this->Place(_lower, _index, slot);
+      }
+
+      /// \brief Restore the heap order around an entry whose value changed.
+      /// \param[in] _lower True for the lower half, false for the upper.
+      /// \param[in] _index Position in the heap.
+      private: void Restore(bool _lower, size_t _index)
+      {
+        this->SiftDown(_lower, this->SiftUp(_lower, _index));
+      }
+
+      /// \brief Add a slot to a heap.
+      /// \param[in] _lower True for the lower half, false for the upper.
+      /// \param[in] _slot Slot to add.
+      private: void Push(bool _lower, size_t _slot)
+      {
+        const size_t index = this->HeapCount(_lower)++;
+        this->Place(_lower, index, _slot);
+        this->SiftUp(_lower, index);
+      }
+
+      /// \brief Remove the top slot of a heap.
+      /// \param[in] _lower True for the lower half, false for the upper.
+      /// \return The removed slot.
+      private: size_t Pop(bool _lower)
+      {
+        std::vector<size_t> &heap = this->Heap(_lower);
+        const size_t top = heap[0];
+        const size_t count = --this->HeapCount(_lower);
+        if (count > 0)
+        {
+          this->Place(_lower, 0, heap[count]);
+          this->SiftDown(_lower, 0);
+        }
+        return top;
+      }
+
+      /// \brief Ring buffer of values.
+      private: std::vector<T> values;
+
+      /// \brief Position of each slot in its heap.
+      private: std::vector<size_t> heapIndex;
+
+      /// \brief Whether each slot is in the lower half heap.
+      private: std::vector<bool> inLower;
+
+      /// \brief Max-heap of the slots of the lower half of the values.
+      private: std::vector<size_t> lower;
+
+      /// \brief Min-heap of the slots of the upper half of the values.
+      private: std::vector<size_t> upper;
+
+      /// \brief Number of slots in the lower half heap.
+      private: size_t lowerCount = 0;
+
+      /// \brief Number of slots in the upper half heap.
+      private: size_t upperCount = 0;
+
+      /// \brief Index of the slot of the next value.
+      private: size_t next = 0;
+
+      /// \brief Number of values in the window.
+      private: size_t samples = 0;
+    };
+    }
+  }
+}
+
+#endif
@@ -17,6 +17,7 @@
 #ifndef IGNITION_MATH_MOVINGWINDOWFILTER_HH_
 #define IGNITION_MATH_MOVINGWINDOWFILTER_HH_
 
+#include <array>
 #include <memory>
 #include <vector>
 #include "ignition/math/Export.hh"
@@ -184,6 +185,93 @@ namespace ignition
     {
       return this->dataPtr->sum / static_cast<double>(this->dataPtr->samples);
     }
+
+    /// \brief Moving window filter with a compile-time maximum window
+    /// size and inline storage.
+    ///
+    /// This has the same interface and produces the same values as
+    /// MovingWindowFilter, but the history is stored in a std::array
+    /// member instead of a heap-allocated std::vector, so constructing
+    /// the filter does not allocate and Update only touches the filter
+    /// object itself. This makes it suitable for large arrays of filters.
+    ///
+    /// The default window size is N, and SetWindowSize accepts sizes up
+    /// to N.
+    template<typename T, unsigned int N>
+    class StaticMovingWindowFilter
+    {
+      static_assert(N > 0, "StaticMovingWindowFilter requires N > 0");
+
+      /// \brief Update value of filter
+      /// \param[in] _val new raw value
+      public: void Update(const T _val)
+      {
+        // keep running sum
+        this->sum += _val;
+
+        if (this->samples == this->valWindowSize)
+        {
+          // subtract the oldest value if the buffer is already filled
+          this->sum -= this->valHistory[this->index];
+        }
+        else
+        {
+          ++this->samples;
+        }
+
+        // put new value into the queue and wrap around at the window size
+        this->valHistory[this->index] = _val;
+        if (++this->index == this->valWindowSize)
+          this->index = 0;
+      }
+
+      /// \brief Set window size. This also clears the history.
+      /// \param[in] _n new desired window size. Values larger than N are
+      /// replaced by N, and zero is replaced by one.
+      public: void SetWindowSize(const unsigned int _n)
+      {
+        this->valWindowSize = _n == 0 ? 1u : (_n > N ? N : _n);
+        this->index = 0;
+        this->samples = 0;
+        this->sum = T();
+      }
+
+      /// \brief Get the window size.
+      /// \return The size of the moving window.
+      public: unsigned int WindowSize() const
+      {
+        return this->valWindowSize;
+      }
+
+      /// \brief Get whether the window has been filled.
+      /// \return True if the window has been filled.
+      public: bool WindowFilled() const
+      {
+        return this->samples == this->valWindowSize;
+      }
+
+      /// \brief Get filtered result
+      /// \return Latest filtered value
+      public: T Value() const
+      {
+        return this->sum / static_cast<double>(this->samples);
+      }
+
+      /// \brief For moving window smoothed value
+      private: unsigned int valWindowSize = N;
+
+      /// \brief Index of the slot of the next value in the history
+      private: unsigned int index = 0;
+
+      /// \brief keep track of number of elements
+      private: unsigned int samples = 0;
+
+      /// \brief keep track of running sum
+      private: T sum = T();
+
+      /// \brief buffer history of raw values
+      private: std::array<T, N> valHistory{};
+    };
     }
   }
 }
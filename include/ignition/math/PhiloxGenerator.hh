@@ -0,0 +1,313 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_PHILOXGENERATOR_HH_
+#define IGNITION_MATH_PHILOXGENERATOR_HH_
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class PhiloxGenerator PhiloxGenerator.hh
+    /// ignition/math/PhiloxGenerator.hh
+    /// \brief Counter-based random number generator using the
+    /// Philox4x32-10 function of Salmon et al., "Parallel Random Numbers:
+    /// As Easy as 1, 2, 3", 2011.
+    ///
+    /// Every value is a pure function of a seed, a stream index and a
+    /// counter: Block() encrypts the 64 bit counter and 64 bit stream
+    /// with the 64 bit seed as key. Each entity or sensor can therefore
+    /// use its own stream, and any value of any stream can be computed
+    /// directly, so results do not depend on how work is split between
+    /// threads or in which order it runs.
+    ///
+    /// Each call to DblUniform, DblNormal or IntUniform uses the block at
+    /// the current counter and then increments the counter by one. Fill
+    /// functions use one block for every two doubles or four floats, so
+    /// value j of a fill that starts at counter c comes from block
+    /// c + j / 2 for doubles, or c + j / 4 for floats, and the counter
+    /// advances past the last block used.
+    class PhiloxGenerator
+    {
+      /// \brief Constructor.
+      /// \param[in] _seed Seed, used as the key.
+      /// \param[in] _stream Stream index.
+      /// \param[in] _counter Initial counter.
+      public: explicit PhiloxGenerator(uint64_t _seed = 0,
+                  uint64_t _stream = 0, uint64_t _counter = 0)
+        : seed(_seed), stream(_stream), counter(_counter)
+      {
+      }
+
+      /// \brief Get the seed.
+      /// \return Seed.
+      public: uint64_t Seed() const
+      {
+        return this->seed;
+      }
+
+      /// \brief Get the stream index.
+      /// \return Stream index.
+      public: uint64_t Stream() const
+      {
+        return this->stream;
+      }
+
+      /// \brief Get the counter of the next block.
+      /// \return Counter.
+      public: uint64_t Counter() const
+      {
+        return this->counter;
+      }
+
+      /// \brief Set the counter of the next block.
+      /// \param[in] _counter Counter.
+      public: void SetCounter(uint64_t _counter)
+      {
+        this->counter = _counter;
+      }
+
+      /// \brief Compute one block of random bits.
+      /// \param[in] _seed Seed, used as the key.
+      /// \param[in] _stream Stream index.
+      /// \param[in] _counter Counter.
+      /// \return Four uniformly distributed 32 bit values.
+      public: static std::array<uint32_t, 4> Block(uint64_t _seed,
+                  uint64_t _stream, uint64_t _counter)
+      {
+        uint32_t c[4] = {static_cast<uint32_t>(_counter),
+          static_cast<uint32_t>(_counter >> 32),
+          static_cast<uint32_t>(_stream),
+          static_cast<uint32_t>(_stream >> 32)};
+        uint32_t k0 = static_cast<uint32_t>(_seed);
+        uint32_t k1 = static_cast<uint32_t>(_seed >> 32);
+
+        for (int round = 0; round < 10; ++round)
+        {
+          const uint64_t p0 = uint64_t(0xD2511F53u) * c[0];
+          const uint64_t p1 = uint64_t(0xCD9E8D57u) * c[2];
+          const uint32_t hi0 = static_cast<uint32_t>(p0 >> 32);
+          const uint32_t lo0 = static_cast<uint32_t>(p0);
+          const uint32_t hi1 = static_cast<uint32_t>(p1 >> 32);
+          const uint32_t lo1 = static_cast<uint32_t>(p1);
+          c[0] = hi1 ^ c[1] ^ k0;
+          c[1] = lo1;
+          c[2] = hi0 ^ c[3] ^ k1;
+          c[3] = lo0;
+          k0 += 0x9E3779B9u;
+          k1 += 0xBB67AE85u;
+        }
+        return {{c[0], c[1], c[2], c[3]}};
+      }
+
+      /// \brief Get a double from a uniform distribution in [_min, _max).
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return Random number.
+      public: double DblUniform(double _min = 0, double _max = 1)
+      {
+        const auto block = this->NextBlock();
+        return _min + (_max - _min) * UnitDouble(block[0], block[1]);
+      }
+
+      /// \brief Get a double from a normal distribution, using the
+      /// Box-Muller transform of one block.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \return Random number.
+      public: double DblNormal(double _mean = 0, double _sigma = 1)
+      {
+        double z0;
+        double z1;
+        BoxMuller(this->NextBlock(), z0, z1);
+        return _mean + _sigma * z0;
+      }
+
+      /// \brief Get an integer from a uniform distribution in [_min,
+      /// _max].
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return Random number, or _min if _max is less than _min.
+      public: int32_t IntUniform(int _min, int _max)
+      {
+        const auto block = this->NextBlock();
+        if (_max <= _min)
+          return _min;
+
+        // Scale 64 random bits to the range. The bias is below 2^-32.
+        const uint64_t range = static_cast<uint64_t>(
+            static_cast<int64_t>(_max) - _min) + 1;
+        const uint64_t bits = (static_cast<uint64_t>(block[0]) << 32) |
+          block[1];
+        const uint64_t offset = MulHigh64(bits, range);
+        return static_cast<int32_t>(_min + static_cast<int64_t>(offset));
+      }
+
+      /// \brief Fill a vector with values from a uniform distribution in
+      /// [_min, _max).
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: void FillUniform(std::vector<double> &_values,
+                  double _min = 0, double _max = 1)
+      {
+        const double range = _max - _min;
+        const size_t size = _values.size();
+        for (size_t i = 0; i < size; i += 2)
+        {
+          const auto block = this->NextBlock();
+          _values[i] = _min + range * UnitDouble(block[0], block[1]);
+          if (i + 1 < size)
+            _values[i + 1] = _min + range * UnitDouble(block[2], block[3]);
+        }
+      }
+
+      /// \brief Fill a vector with values from a uniform distribution in
+      /// [_min, _max).
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: void FillUniform(std::vector<float> &_values,
+                  float _min = 0, float _max = 1)
+      {
+        const float range = _max - _min;
+        const size_t size = _values.size();
+        for (size_t i = 0; i < size; i += 4)
+        {
+          const auto block = this->NextBlock();
+          for (size_t j = 0; j < 4 && i + j < size; ++j)
+          {
+            _values[i + j] = _min + range *
+              (static_cast<float>(block[j] >> 8) * 0x1.0p-24f);
+          }
+        }
+      }
+
+      /// \brief Fill a vector with values from a normal distribution.
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: void FillNormal(std::vector<double> &_values,
+                  double _mean = 0, double _sigma = 1)
+      {
+        const size_t size = _values.size();
+        for (size_t i = 0; i < size; i += 2)
+        {
+          double z0;
+          double z1;
+          BoxMuller(this->NextBlock(), z0, z1);
+          _values[i] = _mean + _sigma * z0;
+          if (i + 1 < size)
+            _values[i + 1] = _mean + _sigma * z1;
+        }
+      }
+
+      /// \brief Fill a vector with values from a normal distribution.
+      /// Each block gives two floats, as for doubles.
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: void FillNormal(std::vector<float> &_values,
+                  float _mean = 0, float _sigma = 1)
+      {
+        const size_t size = _values.size();
+        for (size_t i = 0; i < size; i += 2)
+        {
+          double z0;
+          double z1;
+          BoxMuller(this->NextBlock(), z0, z1);
+          _values[i] = _mean + _sigma * static_cast<float>(z0);
+          if (i + 1 < size)
+            _values[i + 1] = _mean + _sigma * static_cast<float>(z1);
+        }
+      }
+
+      /// \brief Compute the block at the counter and increment it.
+      /// \return Block.
+      private: std::array<uint32_t, 4> NextBlock()
+      {
+        return Block(this->seed, this->stream, this->counter++);
+      }
+
+      /// \brief Convert two 32 bit values to a double in [0, 1) with 53
+      /// random bits.
+      /// \param[in] _hi Upper bits.
+      /// \param[in] _lo Lower bits.
+      /// \return Uniform double.
+      private: static double UnitDouble(uint32_t _hi, uint32_t _lo)
+      {
+        const uint64_t bits = (static_cast<uint64_t>(_hi) << 32) | _lo;
+        return static_cast<double>(bits >> 11) * 0x1.0p-53;
+      }
+
+      /// \brief Transform a block into two independent standard normal
+      /// values.
+      /// \param[in] _block Random bits.
+      /// \param[out] _z0 First normal value.
+      /// \param[out] _z1 Second normal value.
+      private: static void BoxMuller(const std::array<uint32_t, 4> &_block,
+                   double &_z0, double &_z1)
+      {
+        // u1 is in (0, 1] so the logarithm is finite.
+        const double u1 = 1.0 - UnitDouble(_block[0], _block[1]);
+        const double u2 = UnitDouble(_block[2], _block[3]);
+        const double r = std::sqrt(-2.0 * std::log(u1));
+        _z0 = r * std::cos(2.0 * IGN_PI * u2);
+        _z1 = r * std::sin(2.0 * IGN_PI * u2);
+      }
+
+      /// \brief Upper 64 bits of the 128 bit product of two values.
+      /// \param[in] _a First value.
+      /// \param[in] _b Second value.
+      /// \return Upper half of the product.
+      private: static uint64_t MulHigh64(uint64_t _a, uint64_t _b)
+      {
+        const uint64_t aLo = _a & 0xffffffffu;
+        const uint64_t aHi = _a >> 32;
+        const uint64_t bLo = _b & 0xffffffffu;
+        const uint64_t bHi = _b >> 32;
+        const uint64_t lolo = aLo * bLo;
+        const uint64_t hilo = aHi * bLo;
+        const uint64_t lohi = aLo * bHi;
+        const uint64_t hihi = aHi * bHi;
+        const uint64_t cross = (lolo >> 32) + (hilo & 0xffffffffu) + lohi;
+        return hihi + (hilo >> 32) + (cross >> 32);
+      }
+
+      /// \brief Seed, used as the key.
+      private: uint64_t seed;
+
+      /// \brief Stream index.
+      private: uint64_t stream;
+
+      /// \brief Counter of the next block.
+      private: uint64_t counter;
+    };
+    }
+  }
+}
+
+#endif
@@ -17,9 +17,11 @@
 #ifndef IGNITION_MATH_RAND_HH_
 #define IGNITION_MATH_RAND_HH_
 
+#include <atomic>
 #include <random>
 #include <cmath>
 #include <cstdint>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/config.hh>
 
@@ -45,6 +47,15 @@ namespace ignition
 
     /// \class Rand Rand.hh ignition/math/Rand.hh
     /// \brief Random number generator class
+    ///
+    /// Each thread uses its own generator, so the static functions can be
+    /// called from several threads without synchronization. Seed reseeds
+    /// the generator of the calling thread with stream 0 of the seed, as
+    /// RandomGenerator(_seed) does, and the generators of the other
+    /// threads with other streams of the same seed the next time they are
+    /// used. A single threaded program therefore gets the same sequence
+    /// for a given seed as before, and threads never share a stream.
+    /// \sa RandomGenerator
     class IGNITION_MATH_VISIBLE Rand
     {
       /// \brief Set the seed value.
@@ -77,12 +88,46 @@ namespace ignition
       /// \param[in] _sigma Sigma value for the distribution
       public: static int32_t IntNormal(int _mean, int _sigma);
 
+      /// \brief Fill a vector with values from a uniform distribution in
+      /// [_min, _max), using the fast bulk path of RandomGenerator.
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      /// \sa RandomGenerator::FillUniform
+      public: static void FillUniform(std::vector<double> &_values,
+                  double _min = 0, double _max = 1);
+
+      /// \brief Fill a vector with values from a uniform distribution in
+      /// [_min, _max).
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: static void FillUniform(std::vector<float> &_values,
+                  float _min = 0, float _max = 1);
+
+      /// \brief Fill a vector with values from a normal distribution,
+      /// using the fast bulk path of RandomGenerator.
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \sa RandomGenerator::FillNormal
+      public: static void FillNormal(std::vector<double> &_values,
+                  double _mean = 0, double _sigma = 1);
+
+      /// \brief Fill a vector with values from a normal distribution.
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: static void FillNormal(std::vector<float> &_values,
+                  float _mean = 0, float _sigma = 1);
+
       /// \brief Get a mutable reference to the seed (create the static
       /// member if it hasn't been created yet).
-      private: static uint32_t &SeedMutable();
+      private: static std::atomic<uint32_t> &SeedMutable();
 
-      /// \brief Get a mutable reference to the random generator (create the
-      /// static member if it hasn't been created yet).
+      /// \brief Get a mutable reference to the random generator of the
+      /// calling thread, reseeding it if Seed was called since it was last
+      /// used.
       private: static GeneratorType &RandGenerator();
     };
     }
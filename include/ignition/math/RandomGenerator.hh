@@ -0,0 +1,301 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_RANDOMGENERATOR_HH_
+#define IGNITION_MATH_RANDOMGENERATOR_HH_
+
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Rand.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class RandomGeneratorPrivate;
+
+    /// \class Xoshiro256PlusPlus RandomGenerator.hh
+    /// ignition/math/RandomGenerator.hh
+    /// \brief The xoshiro256++ 64 bit pseudo random number engine by
+    /// Blackman and Vigna.
+    ///
+    /// It has a 256 bit state, a period of 2^256 - 1, passes common
+    /// statistical test suites, and produces each value with a few shifts,
+    /// rotations and additions, which makes it several times faster than
+    /// std::mt19937. It meets the requirements of a uniform random bit
+    /// generator, so it can be used with the standard library
+    /// distributions.
+    /// \sa https://prng.di.unimi.it/
+    class Xoshiro256PlusPlus
+    {
+      /// \brief Type of the generated values.
+      public: using result_type = uint64_t;
+
+      /// \brief Constructor.
+      /// \param[in] _seed Seed value.
+      public: explicit Xoshiro256PlusPlus(uint64_t _seed = 0)
+      {
+        this->seed(_seed);
+      }
+
+      /// \brief Seed the engine. The state is filled with the splitmix64
+      /// sequence of the seed, as recommended by the authors.
+      /// \param[in] _seed Seed value.
+      public: void seed(uint64_t _seed)
+      {
+        for (uint64_t &word : this->state)
+        {
+          _seed += 0x9e3779b97f4a7c15ull;
+          uint64_t z = _seed;
+          z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+          z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+          word = z ^ (z >> 31);
+        }
+      }
+
+      /// \brief Seed the engine from a seed sequence.
+      /// \param[in] _seq Seed sequence.
+      public: template<typename SeedSeq, typename = std::enable_if_t<
+                  !std::is_arithmetic<SeedSeq>::value>>
+              void seed(SeedSeq &_seq)
+      {
+        uint32_t words[8];
+        _seq.generate(words, words + 8);
+        for (int i = 0; i < 4; ++i)
+        {
+          this->state[i] = (static_cast<uint64_t>(words[2 * i]) << 32) |
+            words[2 * i + 1];
+        }
+
+        // The all zero state is the only invalid one.
+        if (!(this->state[0] | this->state[1] | this->state[2] |
+              this->state[3]))
+        {
+          this->seed(0);
+        }
+      }
+
+      /// \brief Smallest value returned by operator().
+      /// \return Zero.
+      public: static constexpr result_type min()
+      {
+        return 0;
+      }
+
+      /// \brief Largest value returned by operator().
+      /// \return 2^64 - 1.
+      public: static constexpr result_type max()
+      {
+        return ~result_type(0);
+      }
+
+      /// \brief Generate the next value.
+      /// \return A uniformly distributed 64 bit value.
+      public: result_type operator()()
+      {
+        uint64_t *s = this->state;
+        const uint64_t result = Rotl(s[0] + s[3], 23) + s[0];
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = Rotl(s[3], 45);
+        return result;
+      }
+
+      /// \brief Advance the engine by 2^128 values. Calling this
+      /// repeatedly on copies of an engine gives non-overlapping
+      /// subsequences for parallel use.
+      public: void Jump()
+      {
+        static const uint64_t kJump[] = {0x180ec6d33cfd0abaull,
+          0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull,
+          0x39abdc4529b1661cull};
+
+        uint64_t s[4] = {0, 0, 0, 0};
+        for (const uint64_t jump : kJump)
+        {
+          for (int b = 0; b < 64; ++b)
+          {
+            if (jump & (uint64_t(1) << b))
+            {
+              for (int i = 0; i < 4; ++i)
+                s[i] ^= this->state[i];
+            }
+            (*this)();
+          }
+        }
+        for (int i = 0; i < 4; ++i)
+          this->state[i] = s[i];
+      }
+
+      /// \brief Rotate bits left.
+      /// \param[in] _x Value.
+      /// \param[in] _k Number of bits, between 1 and 63.
+      /// \return Rotated value.
+      private: static uint64_t Rotl(uint64_t _x, int _k)
+      {
+        return (_x << _k) | (_x >> (64 - _k));
+      }
+
+      /// \brief Engine state.
+      private: uint64_t state[4];
+    };
+
+    /// \class RandomGenerator RandomGenerator.hh
+    /// ignition/math/RandomGenerator.hh
+    /// \brief Random number generator with its own state.
+    ///
+    /// Unlike the static functions of Rand, which use a generator per
+    /// thread, a RandomGenerator can be owned by an object or a thread, so
+    /// it needs no synchronization and its sequence does not depend on
+    /// other users. A generator is seeded with a seed and a stream index:
+    /// generators with the same seed and stream produce the same values,
+    /// and different streams of the same seed are independent. Stream 0
+    /// produces the same values as Rand after Rand::Seed is called with
+    /// the same seed.
+    ///
+    /// The Fill functions generate many values at once. They use a
+    /// separate Xoshiro256PlusPlus engine, seeded from the same seed and
+    /// stream, and sample normal values with the Ziggurat method, which is
+    /// much faster than calling DblNormal in a loop. Their values do not
+    /// depend on calls to the other functions, and vice versa.
+    ///
+    /// A RandomGenerator must not be used by several threads at the same
+    /// time.
+    class IGNITION_MATH_VISIBLE RandomGenerator
+    {
+      /// \brief Constructor. The generator is seeded from
+      /// std::random_device, with stream 0.
+      public: RandomGenerator();
+
+      /// \brief Constructor.
+      /// \param[in] _seed Seed.
+      /// \param[in] _stream Stream index.
+      public: explicit RandomGenerator(unsigned int _seed,
+                  uint64_t _stream = 0);
+
+      /// \brief Copy constructor. The copy continues the same sequence.
+      /// \param[in] _other Generator to copy.
+      public: RandomGenerator(const RandomGenerator &_other);
+
+      /// \brief Destructor.
+      public: ~RandomGenerator();
+
+      /// \brief Assignment operator. This copies the state of the other
+      /// generator.
+      /// \param[in] _other Generator to copy.
+      /// \return Reference to this generator.
+      public: RandomGenerator &operator=(const RandomGenerator &_other);
+
+      /// \brief Reseed the generator.
+      /// \param[in] _seed Seed.
+      /// \param[in] _stream Stream index.
+      public: void Seed(unsigned int _seed, uint64_t _stream = 0);
+
+      /// \brief Get the seed value.
+      /// \return The seed used to initialize the generator.
+      public: unsigned int Seed() const;
+
+      /// \brief Get the stream index.
+      /// \return The stream index used to initialize the generator.
+      public: uint64_t Stream() const;
+
+      /// \brief Get a double from a uniform distribution
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return Random number.
+      public: double DblUniform(double _min = 0, double _max = 1);
+
+      /// \brief Get a double from a normal distribution
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \return Random number.
+      public: double DblNormal(double _mean = 0, double _sigma = 1);
+
+      /// \brief Get an integer from a uniform distribution
+      /// \param[in] _min Minimum bound for the random number
+      /// \param[in] _max Maximum bound for the random number
+      /// \return Random number.
+      public: int32_t IntUniform(int _min, int _max);
+
+      /// \brief Get an integer from a normal distribution
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      /// \return Random number.
+      public: int32_t IntNormal(int _mean, int _sigma);
+
+      /// \brief Fill a vector with values from a uniform distribution in
+      /// [_min, _max).
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: void FillUniform(std::vector<double> &_values,
+                  double _min = 0, double _max = 1);
+
+      /// \brief Fill a vector with values from a uniform distribution in
+      /// [_min, _max).
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _min Minimum bound for the random numbers
+      /// \param[in] _max Maximum bound for the random numbers
+      public: void FillUniform(std::vector<float> &_values,
+                  float _min = 0, float _max = 1);
+
+      /// \brief Fill a vector with values from a normal distribution.
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: void FillNormal(std::vector<double> &_values,
+                  double _mean = 0, double _sigma = 1);
+
+      /// \brief Fill a vector with values from a normal distribution.
+      /// \param[in,out] _values Values to overwrite. The size is kept.
+      /// \param[in] _mean Mean value for the distribution
+      /// \param[in] _sigma Sigma value for the distribution
+      public: void FillNormal(std::vector<float> &_values,
+                  float _mean = 0, float _sigma = 1);
+
+      /// \brief Get the underlying engine, for use with other standard
+      /// library distributions.
+      /// \return Reference to the engine.
+      public: GeneratorType &Generator();
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<RandomGeneratorPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,323 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_RESAMPLER_HH_
+#define IGNITION_MATH_RESAMPLER_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+#include <vector>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \brief Design a linear phase low-pass FIR filter with the windowed
+    /// sinc method and a Hamming window. The taps are normalized so the
+    /// gain at DC is one.
+    /// \param[in] _taps Number of taps. Zero is replaced by one.
+    /// \param[in] _fc Cutoff frequency.
+    /// \param[in] _fs Sample rate.
+    /// \return Filter taps, in order of increasing delay.
+    inline std::vector<double> FirLowPass(unsigned int _taps, double _fc,
+        double _fs)
+    {
+      const unsigned int taps = std::max(_taps, 1u);
+      const double cutoff = 2.0 * _fc / _fs;
+      const double center = (taps - 1) / 2.0;
+
+      std::vector<double> result(taps);
+      double sum = 0.0;
+      for (unsigned int i = 0; i < taps; ++i)
+      {
+        const double t = i - center;
+        const double sinc = std::abs(t) < 1e-12 ? cutoff :
+          std::sin(IGN_PI * cutoff * t) / (IGN_PI * t);
+        const double window = taps == 1 ? 1.0 :
+          0.54 - 0.46 * std::cos(2.0 * IGN_PI * i / (taps - 1));
+        result[i] = sinc * window;
+        sum += result[i];
+      }
+
+      for (double &tap : result)
+        tap /= sum;
+      return result;
+    }
+
+    /// \brief Design the anti-aliasing and anti-imaging filter of a
+    /// resampler that changes the sample rate by _up / _down. The cutoff
+    /// frequency is 90% of the lower of the two Nyquist frequencies.
+    /// \param[in] _up Upsampling factor.
+    /// \param[in] _down Downsampling factor.
+    /// \param[in] _tapsPerPhase Number of taps of each polyphase branch.
+    /// The filter has _up * _tapsPerPhase taps.
+    /// \return Filter taps, in order of increasing delay, at the upsampled
+    /// rate.
+    inline std::vector<double> FirResamplingTaps(unsigned int _up,
+        unsigned int _down, unsigned int _tapsPerPhase = 16)
+    {
+      const unsigned int up = std::max(_up, 1u);
+      const unsigned int down = std::max(_down, 1u);
+      return FirLowPass(up * std::max(_tapsPerPhase, 1u),
+          0.45, std::max(up, down));
+    }
+
+    /// \class PolyphaseResampler Resampler.hh ignition/math/Resampler.hh
+    /// \brief Changes the sample rate of a signal by a rational factor
+    /// _up / _down with a polyphase FIR filter.
+    ///
+    /// Conceptually the input is upsampled by inserting _up - 1 zeros
+    /// between samples, low-pass filtered and then decimated by keeping
+    /// every _down-th sample. The filter is split into _up polyphase
+    /// branches, and only the retained outputs are computed, each with one
+    /// branch, so the cost per output is the number of taps per branch.
+    ///
+    /// Several channels can be processed together. Blocks are interleaved
+    /// frames, with one sample per channel in each frame, as in
+    /// OnePoleBank. Blocks can have any number of frames, and the state is
+    /// kept between blocks. The first output is aligned with the first
+    /// input.
+    template<typename T>
+    class PolyphaseResampler
+    {
+      static_assert(std::is_floating_point<T>::value,
+          "PolyphaseResampler requires a floating point type");
+
+      /// \brief Constructor with a filter from FirResamplingTaps.
+      /// \param[in] _up Upsampling factor. Zero is replaced by one.
+      /// \param[in] _down Downsampling factor. Zero is replaced by one.
+      /// \param[in] _channels Number of channels. Zero is replaced by one.
+      public: PolyphaseResampler(unsigned int _up, unsigned int _down,
+                  size_t _channels = 1)
+        : PolyphaseResampler(_up, _down, FirResamplingTaps(_up, _down),
+            _channels)
+      {
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _up Upsampling factor. Zero is replaced by one.
+      /// \param[in] _down Downsampling factor. Zero is replaced by one.
+      /// \param[in] _taps Filter taps at the upsampled rate, in order of
+      /// increasing delay, with unit gain at DC. The taps are scaled by
+      /// _up to make up for the inserted zeros.
+      /// \param[in] _channels Number of channels. Zero is replaced by one.
+      public: PolyphaseResampler(unsigned int _up, unsigned int _down,
+                  const std::vector<double> &_taps, size_t _channels = 1)
+        : up(std::max(_up, 1u)), down(std::max(_down, 1u)),
+          channels(std::max<size_t>(_channels, 1))
+      {
+        // Branch p has taps p, p + up, p + 2 up, ... They are stored in
+        // reverse, so each output is a dot product with consecutive
+        // input frames.
+        this->tapsPerPhase = std::max<size_t>(
+            (_taps.size() + this->up - 1) / this->up, 1);
+        this->phases.assign(this->up * this->tapsPerPhase, 0);
+        for (size_t p = 0; p < this->up; ++p)
+        {
+          for (size_t j = 0; j < this->tapsPerPhase; ++j)
+          {
+            const size_t k = p + j * this->up;
+            if (k < _taps.size())
+            {
+              const size_t index =
+                p * this->tapsPerPhase + this->tapsPerPhase - 1 - j;
+              this->phases[index] = static_cast<T>(_taps[k] * this->up);
+            }
+          }
+        }
+        this->Reset();
+      }
+
+      /// \brief Get the upsampling factor.
+      /// \return Upsampling factor.
+      public: unsigned int Up() const
+      {
+        return this->up;
+      }
+
+      /// \brief Get the downsampling factor.
+      /// \return Downsampling factor.
+      public: unsigned int Down() const
+      {
+        return this->down;
+      }
+
+      /// \brief Get the number of channels.
+      /// \return Number of channels.
+      public: size_t Channels() const
+      {
+        return this->channels;
+      }
+
+      /// \brief Get the number of taps of each polyphase branch.
+      /// \return Number of taps per branch.
+      public: size_t TapsPerPhase() const
+      {
+        return this->tapsPerPhase;
+      }
+
+      /// \brief Forget all previous input. The next output is aligned with
+      /// the next input.
+      public: void Reset()
+      {
+        this->edge.assign((this->tapsPerPhase - 1) * this->channels, 0);
+        this->nextFrame = this->tapsPerPhase - 1;
+        this->nextPhase = 0;
+      }
+
+      /// \brief Resample a block of frames.
+      /// \param[in] _in Interleaved input frames. The size must be a
+      /// multiple of Channels().
+      /// \param[out] _out Interleaved output frames. It is resized to the
+      /// number of outputs produced by this block times Channels(). It must
+      /// not be the same vector as _in.
+      /// \return False if the size of _in is not a multiple of Channels(),
+      /// in which case nothing is processed and _out is cleared.
+      public: bool Process(const std::vector<T> &_in, std::vector<T> &_out)
+      {
+        _out.clear();
+        if (_in.size() % this->channels != 0)
+          return false;
+
+        // Frames are numbered from the start of the history, which holds
+        // the last tapsPerPhase - 1 frames of the previous blocks. Windows
+        // that start in the history read from the edge buffer, where the
+        // history is followed by the first frames of this block, and the
+        // other windows read from _in directly.
+        const size_t c = this->channels;
+        const size_t history = this->tapsPerPhase - 1;
+        const size_t inFrames = _in.size() / c;
+        const size_t frames = history + inFrames;
+        const size_t edgeFrames = std::min(history, inFrames);
+        this->edge.insert(this->edge.end(), _in.begin(),
+            _in.begin() + edgeFrames * c);
+
+        if (this->nextFrame < frames)
+        {
+          _out.reserve(c * (((frames - this->nextFrame) * this->up -
+              this->nextPhase) / this->down + 1));
+        }
+        while (this->nextFrame < frames)
+        {
+          const size_t start = this->nextFrame - history;
+          const T *x = start < history ? &this->edge[start * c] :
+            &_in[(start - history) * c];
+          const T *h = &this->phases[this->nextPhase * this->tapsPerPhase];
+
+          const size_t offset = _out.size();
+          _out.resize(offset + c, 0);
+          T *y = &_out[offset];
+          for (size_t i = 0; i < this->tapsPerPhase; ++i)
+          {
+            const T tap = h[i];
+            for (size_t ch = 0; ch < c; ++ch)
+              y[ch] += tap * x[i * c + ch];
+          }
+
+          this->nextPhase += this->down;
+          this->nextFrame += this->nextPhase / this->up;
+          this->nextPhase %= this->up;
+        }
+
+        // Keep the last frames as the history of the next block.
+        this->nextFrame -= inFrames;
+        if (inFrames >= history)
+        {
+          std::copy(_in.end() - history * c, _in.end(), this->edge.begin());
+        }
+        else
+        {
+          std::copy(this->edge.begin() + inFrames * c, this->edge.end(),
+              this->edge.begin());
+        }
+        this->edge.resize(history * c);
+        return true;
+      }
+
+      /// \brief Upsampling factor.
+      private: unsigned int up;
+
+      /// \brief Downsampling factor.
+      private: unsigned int down;
+
+      /// \brief Number of channels.
+      private: size_t channels;
+
+      /// \brief Number of taps of each polyphase branch.
+      private: size_t tapsPerPhase;
+
+      /// \brief Reversed taps of each branch, one branch after the other.
+      private: std::vector<T> phases;
+
+      /// \brief Last tapsPerPhase - 1 input frames, followed by the first
+      /// frames of the current block while it is processed.
+      private: std::vector<T> edge;
+
+      /// \brief Frame of the next output, counted from the start of the
+      /// history.
+      private: size_t nextFrame = 0;
+
+      /// \brief Polyphase branch of the next output.
+      private: size_t nextPhase = 0;
+    };
+
+    /// \class FirDecimator Resampler.hh ignition/math/Resampler.hh
+    /// \brief Low-pass filters a signal and keeps one sample out of
+    /// _factor, computing only the retained outputs.
+    ///
+    /// This is a PolyphaseResampler with an upsampling factor of one.
+    template<typename T>
+    class FirDecimator : public PolyphaseResampler<T>
+    {
+      /// \brief Constructor with a filter from FirResamplingTaps.
+      /// \param[in] _factor Decimation factor. Zero is replaced by one.
+      /// \param[in] _channels Number of channels. Zero is replaced by one.
+      public: explicit FirDecimator(unsigned int _factor,
+                  size_t _channels = 1)
+        : FirDecimator(_factor,
+            FirResamplingTaps(1, _factor, 8 * std::max(_factor, 1u)),
+            _channels)
+      {
+      }
+
+      /// \brief Constructor.
+      /// \param[in] _factor Decimation factor. Zero is replaced by one.
+      /// \param[in] _taps Filter taps, in order of increasing delay.
+      /// \param[in] _channels Number of channels. Zero is replaced by one.
+      public: FirDecimator(unsigned int _factor,
+                  const std::vector<double> &_taps, size_t _channels = 1)
+        : PolyphaseResampler<T>(1, _factor, _taps, _channels)
+      {
+      }
+
+      /// \brief Get the decimation factor.
+      /// \return Decimation factor.
+      public: unsigned int Factor() const
+      {
+        return this->Down();
+      }
+    };
+    }
+  }
+}
+
+#endif
@@ -35,6 +35,8 @@ namespace ignition
     /// The window size determines the maximum number of data points. The
     /// oldest value is popped off when the window size is reached and
     /// a new value is pushed in.
+    /// Push and Mean take constant time and do not allocate.
+    /// \sa RollingWindowMean for other types, such as Vector3d.
     class IGNITION_MATH_VISIBLE RollingMean
     {
       /// \brief Constructor
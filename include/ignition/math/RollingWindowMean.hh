@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_ROLLINGWINDOWMEAN_HH_
+#define IGNITION_MATH_ROLLINGWINDOWMEAN_HH_
+
+#include <cstddef>
+#include <limits>
+#include <vector>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class RollingWindowMean RollingWindowMean.hh
+    /// ignition/math/RollingWindowMean.hh
+    /// \brief Computes the mean over a series of data points of any type
+    /// that supports addition, subtraction, negation and multiplication and
+    /// division by a double, such as double or Vector3d.
+    ///
+    /// The window size determines the maximum number of data points. The
+    /// oldest value is replaced when the window size is reached and a new
+    /// value is pushed in. The values are stored in a ring buffer that is
+    /// allocated when the window size is set, and a running sum is updated
+    /// on every push, so both Push and Mean take constant time and do not
+    /// allocate. The running sum uses Kahan compensation and is recomputed
+    /// from the stored values once per window to bound rounding drift.
+    ///
+    /// \sa RollingMean
+    template<typename T>
+    class RollingWindowMean
+    {
+      /// \brief Constructor
+      /// \param[in] _windowSize The window size to use. This value will be
+      /// ignored if it is equal to zero, and a window size of 10 is used.
+      public: explicit RollingWindowMean(size_t _windowSize = 10)
+      {
+        this->values.resize(_windowSize > 0 ? _windowSize : 10);
+      }
+
+      /// \brief Get the mean value.
+      /// \return The current mean value, or a value where each component
+      /// is std::numeric_limits<double>::quiet_NaN() if data points are not
+      /// present.
+      public: T Mean() const
+      {
+        if (this->count == 0)
+          return T() * std::numeric_limits<double>::quiet_NaN();
+        return this->sum / static_cast<double>(this->count);
+      }
+
+      /// \brief Get the number of data points.
+      /// \return The number of datapoints.
+      public: size_t Count() const
+      {
+        return this->count;
+      }
+
+      /// \brief Insert a new value.
+      /// \param[in] _value New value to insert.
+      public: void Push(const T &_value)
+      {
+        T &slot = this->values[this->next];
+        if (this->count == this->values.size())
+          this->Add(-slot);
+        else
+          ++this->count;
+
+        slot = _value;
+        this->Add(_value);
+
+        if (++this->next == this->values.size())
+        {
+          this->next = 0;
+
+          // Recompute the sum once per window. The cost is amortized over
+          // the window, so Push stays constant time.
+          this->Resum();
+        }
+      }
+
+      /// \brief Remove all the pushed values.
+      public: void Clear()
+      {
+        this->count = 0;
+        this->next = 0;
+        this->sum = T();
+        this->compensation = T();
+      }
+
+      /// \brief Set the new window size. This will also clear the data.
+      /// Nothing happens if the _windowSize is zero.
+      /// \param[in] _windowSize The window size to use.
+      public: void SetWindowSize(size_t _windowSize)
+      {
+        if (_windowSize > 0)
+        {
+          this->values.assign(_windowSize, T());
+          this->Clear();
+        }
+      }
+
+      /// \brief Get the window size.
+      /// \return The window size.
+      public: size_t WindowSize() const
+      {
+        return this->values.size();
+      }
+
+      /// \brief Add a value to the running sum using Kahan summation.
+      /// \param[in] _value Value to add.
+      private: void Add(const T &_value)
+      {
+        const T y = _value - this->compensation;
+        const T t = this->sum + y;
+        this->compensation = (t - this->sum) - y;
+        this->sum = t;
+      }
+
+      /// \brief Recompute the running sum from the stored values.
+      private: void Resum()
+      {
+        this->sum = T();
+        this->compensation = T();
+        for (size_t i = 0; i < this->count; ++i)
+          this->Add(this->values[i]);
+      }
+
+      /// \brief Ring buffer of values.
+      private: std::vector<T> values;
+
+      /// \brief Index of the slot of the next value.
+      private: size_t next = 0;
+
+      /// \brief Number of values in the window.
+      private: size_t count = 0;
+
+      /// \brief Running sum of the values in the window.
+      private: T sum = T();
+
+      /// \brief Running compensation of the Kahan summation.
+      private: T compensation = T();
+    };
+    }
+  }
+}
+
+#endif
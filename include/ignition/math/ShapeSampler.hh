@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_SHAPESAMPLER_HH_
+#define IGNITION_MATH_SHAPESAMPLER_HH_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+#include <ignition/math/Box.hh>
+#include <ignition/math/Capsule.hh>
+#include <ignition/math/Cylinder.hh>
+#include <ignition/math/Ellipsoid.hh>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/OrientedBox.hh>
+#include <ignition/math/Sphere.hh>
+#include <ignition/math/Triangle3.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \class ShapeSampler ShapeSampler.hh ignition/math/ShapeSampler.hh
+    /// \brief Uniform random sampling of points inside and on the surface
+    /// of the math primitives.
+    ///
+    /// Each function overwrites all points of a vector, keeping its size,
+    /// with independent points that are uniformly distributed in the
+    /// volume or over the area of the shape. Shapes are centered at the
+    /// origin as in their own classes: Cylinder samples are rotated by
+    /// its rotational offset and OrientedBox samples are transformed by
+    /// its pose. All samplers are exact and rejection-free, except the
+    /// surface of a non-spherical ellipsoid, which uses rejection with an
+    /// acceptance rate of at least the ratio of its smallest to largest
+    /// radius.
+    ///
+    /// The sampler draws from any uniform random bit generator, such as
+    /// Xoshiro256PlusPlus, std::mt19937 or RandomGenerator::Generator().
+    /// Engines that produce full 32 or 64 bit values use a fast
+    /// conversion to double.
+    ///
+    /// Example:
+    /// \code
+    /// math::Xoshiro256PlusPlus engine(42);
+    /// math::ShapeSampler<math::Xoshiro256PlusPlus> sampler(engine);
+    /// std::vector<math::Vector3d> points(1000);
+    /// sampler.Volume(math::Sphered(2.0), points);
+    /// \endcode
+    /// \tparam Engine Uniform random bit generator type.
+    template<typename Engine>
+    class ShapeSampler
+    {
+      /// \brief Constructor.
+      /// \param[in] _engine Engine to draw from. It must outlive the
+      /// sampler.
+      public: explicit ShapeSampler(Engine &_engine)
+        : engine(_engine)
+      {
+      }
+
+      /// \brief Sample points inside a box.
+      /// \param[in] _box Box.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Volume(const Box<P> &_box,
+                  std::vector<Vector3<P>> &_points)
+      {
+        const Vector3<P> size = _box.Size();
+        for (Vector3<P> &point : _points)
+        {
+          point.Set(size.X() * (this->Uniform<P>() - P(0.5)),
+                    size.Y() * (this->Uniform<P>() - P(0.5)),
+                    size.Z() * (this->Uniform<P>() - P(0.5)));
+        }
+      }
+
+      /// \brief Sample points on the surface of a box.
+      /// \param[in] _box Box.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Surface(const Box<P> &_box,
+                  std::vector<Vector3<P>> &_points)
+      {
+        const Vector3<P> size = _box.Size();
+        const P areaX = size.Y() * size.Z();
+        const P areaY = size.X() * size.Z();
+        const P total = areaX + areaY + size.X() * size.Y();
+        for (Vector3<P> &point : _points)
+        {
+          // u falls in an interval of twice the face area for each pair of
+          // opposite faces, which picks the pair by area. The negative
+          // face is used when u is in the first half of the interval.
+          const P u = this->Uniform<P>() * total * 2;
+          point.Set(size.X() * (this->Uniform<P>() - P(0.5)),
+                    size.Y() * (this->Uniform<P>() - P(0.5)),
+                    size.Z() * (this->Uniform<P>() - P(0.5)));
+          if (u < 2 * areaX)
+            point.X(size.X() * (u < areaX ? P(-0.5) : P(0.5)));
+          else if (u < 2 * (areaX + areaY))
+            point.Y(size.Y() * (u < 2 * areaX + areaY ? P(-0.5) : P(0.5)));
+          else
+            point.Z(size.Z() * (u < total + areaX + areaY ?
+                  P(-0.5) : P(0.5)));
+        }
+      }
+
+      /// \brief Sample points inside an oriented box.
+      /// \param[in] _box Oriented box.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Volume(const OrientedBox<P> &_box,
+                  std::vector<Vector3<P>> &_points)
+      {
+        this->Volume(Box<P>(_box.Size()), _points);
+        for (Vector3<P> &point : _points)
+          point = _box.Pose().CoordPositionAdd(point);
+      }
+
+      /// \brief Sample points on the surface of an oriented box.
+      /// \param[in] _box Oriented box.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Surface(const OrientedBox<P> &_box,
+                  std::vector<Vector3<P>> &_points)
+      {
+        this->Surface(Box<P>(_box.Size()), _points);
+        for (Vector3<P> &point : _points)
+          point = _box.Pose().CoordPositionAdd(point);
+      }
+
+      /// \brief Sample points inside a sphere.
+      /// \param[in] _sphere Sphere.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Volume(const Sphere<P> &_sphere,
+                  std::vector<Vector3<P>> &_points)
+      {
+        for (Vector3<P> &point : _points)
+          point = this->Ball<P>() * _sphere.Radius();
+      }
+
+      /// \brief Sample points on the surface of a sphere.
+      /// \param[in] _sphere Sphere.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Surface(const Sphere<P> &_sphere,
+                  std::vector<Vector3<P>> &_points)
+      {
+        for (Vector3<P> &point : _points)
+          point = this->Direction<P>() * _sphere.Radius();
+      }
+
+      /// \brief Sample points inside a cylinder.
+      /// \param[in] _cylinder Cylinder.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Volume(const Cylinder<P> &_cylinder,
+                  std::vector<Vector3<P>> &_points)
+      {
+        const P radius = _cylinder.Radius();
+        const P length = _cylinder.Length();
+        const Quaternion<P> rot = _cylinder.RotationalOffset();
+        for (Vector3<P> &point : _points)
+        {
+          point = this->Disc<P>(radius);
+          point.Z(length * (this->Uniform<P>() - P(0.5)));
+          point = rot.RotateVector(point);
+        }
+      }
+
+      /// \brief Sample points on the surface of a cylinder, including the
+      /// caps.
+      /// \param[in] _cylinder Cylinder.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Surface(const Cylinder<P> &_cylinder,
+                  std::vector<Vector3<P>> &_points)
+      {
+        const P radius = _cylinder.Radius();
+        const P length = _cylinder.Length();
+        const Quaternion<P> rot = _cylinder.RotationalOffset();
+
+        // Side and cap areas, without the common factor of pi * radius
+        const P side = 2 * length;
+        const P caps = 2 * radius;
+        for (Vector3<P> &point : _points)
+        {
+          const P u = this->Uniform<P>() * (side + caps);
+          if (u < side)
+          {
+            point = this->Circle<P>(radius);
+            point.Z(length * (u / side - P(0.5)));
+          }
+          else
+          {
+            point = this->Disc<P>(radius);
+            point.Z(u < side + radius ? -length / 2 : length / 2);
+          }
+          point = rot.RotateVector(point);
+        }
+      }
+
+      /// \brief Sample points inside a capsule.
+      /// \param[in] _capsule Capsule.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Volume(const Capsule<P> &_capsule,
+                  std::vector<Vector3<P>> &_points)
+      {
+        const P radius = _capsule.Radius();
+        const P length = _capsule.Length();
+
+        // The two hemispheres together form a ball. Volumes are without
+        // the common factor of pi * radius^2.
+        const P cylinder = length;
+        const P ball = radius * 4 / 3;
+        for (Vector3<P> &point : _points)
+        {
+          const P u = this->Uniform<P>() * (cylinder + ball);
+          if (u < cylinder)
+          {
+            point = this->Disc<P>(radius);
+            point.Z(length * (u / cylinder - P(0.5)));
+          }
+          else
+          {
+            point = this->Ball<P>() * radius;
+            point.Z(point.Z() + (point.Z() < 0 ? -length : length) / 2);
+          }
+        }
+      }
+
+      /// \brief Sample points on the surface of a capsule.
+      /// \param[in] _capsule Capsule.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Surface(const Capsule<P> &_capsule,
+                  std::vector<Vector3<P>> &_points)
+      {
+        const P radius = _capsule.Radius();
+        const P length = _capsule.Length();
+
+        // Areas without the common factor of 2 * pi * radius
+        const P side = length;
+        const P sphere = 2 * radius;
+        for (Vector3<P> &point : _points)
+        {
+          const P u = this->Uniform<P>() * (side + sphere);
+          if (u < side)
+          {
+            point = this->Circle<P>(radius);
+            point.Z(length * (u / side - P(0.5)));
+          }
+          else
+          {
+            point = this->Direction<P>() * radius;
+            point.Z(point.Z() + (point.Z() < 0 ? -length : length) / 2);
+          }
+        }
+      }
+
+      /// \brief Sample points inside an ellipsoid.
+      /// \param[in] _ellipsoid Ellipsoid.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Volume(const Ellipsoid<P> &_ellipsoid,
+                  std::vector<Vector3<P>> &_points)
+      {
+        // A linear map keeps the distribution uniform
+        const Vector3<P> radii = _ellipsoid.Radii();
+        for (Vector3<P> &point : _points)
+          point = this->Ball<P>() * radii;
+      }
+
+      /// \brief Sample points on the surface of an ellipsoid.
+      /// \param[in] _ellipsoid Ellipsoid.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Surface(const Ellipsoid<P> &_ellipsoid,
+                  std::vector<Vector3<P>> &_points)
+      {
+        // Scaling a point on the unit sphere stretches the area around it
+        // by a factor proportional to the length of d / radii, so points
+        // are accepted with that factor relative to its maximum.
+        const Vector3<P> radii = _ellipsoid.Radii();
+        const P minRadius = radii.Min();
+        for (Vector3<P> &point : _points)
+        {
+          Vector3<P> dir = this->Direction<P>();
+          if (minRadius > 0)
+          {
+            while (this->Uniform<P>() >= minRadius * (dir / radii).Length())
+              dir = this->Direction<P>();
+          }
+          point = dir * radii;
+        }
+      }
+
+      /// \brief Sample points on a triangle.
+      /// \param[in] _triangle Triangle.
+      /// \param[in,out] _points Points to overwrite.
+      public: template<typename P>
+              void Surface(const Triangle3<P> &_triangle,
+                  std::vector<Vector3<P>> &_points)
+      {
+        const Vector3<P> a = _triangle[0];
+        const Vector3<P> ab = _triangle[1] - a;
+        const Vector3<P> ac = _triangle[2] - a;
+        for (Vector3<P> &point : _points)
+        {
+          const P r = std::sqrt(this->Uniform<P>());
+          const P s = this->Uniform<P>();
+          point = a + ab * (r * (1 - s)) + ac * (r * s);
+        }
+      }
+
+      /// \brief Draw a uniform value in [0, 1).
+      /// \return Uniform value.
+      private: template<typename P>
+               P Uniform()
+      {
+        using Result = typename Engine::result_type;
+        constexpr Result kMin = Engine::min();
+        constexpr Result kMax = Engine::max();
+        double value;
+        if constexpr (kMin == 0 &&
+            kMax == std::numeric_limits<uint64_t>::max())
+        {
+          value = static_cast<double>(
+              static_cast<uint64_t>(this->engine()) >> 11) * 0x1.0p-53;
+        }
+        else if constexpr (kMin == 0 &&
+            kMax == std::numeric_limits<uint32_t>::max())
+        {
+          const uint64_t hi = static_cast<uint32_t>(this->engine());
+          const uint64_t lo = static_cast<uint32_t>(this->engine());
+          value = static_cast<double>(((hi << 32) | lo) >> 11) * 0x1.0p-53;
+        }
+        else
+        {
+          value = std::generate_canonical<double,
+            std::numeric_limits<double>::digits>(this->engine);
+        }
+
+        // Rounding to float can give 1
+        const P result = static_cast<P>(value);
+        return result < 1 ? result : std::nextafter(P(1), P(0));
+      }
+
+      /// \brief Draw a uniformly distributed unit vector.
+      /// \return Unit vector.
+      private: template<typename P>
+               Vector3<P> Direction()
+      {
+        const P z = 2 * this->Uniform<P>() - 1;
+        const P phi = static_cast<P>(2 * IGN_PI) * this->Uniform<P>();
+        const P r = std::sqrt(std::max(P(0), 1 - z * z));
+        return Vector3<P>(r * std::cos(phi), r * std::sin(phi), z);
+      }
+
+      /// \brief Draw a point uniformly distributed in the unit ball.
+      /// \return Point.
+      private: template<typename P>
+               Vector3<P> Ball()
+      {
+        return this->Direction<P>() * std::cbrt(this->Uniform<P>());
+      }
+
+      /// \brief Draw a point uniformly distributed on a circle in the XY
+      /// plane.
+      /// \param[in] _radius Radius.
+      /// \return Point.
+      private: template<typename P>
+               Vector3<P> Circle(P _radius)
+      {
+        const P phi = static_cast<P>(2 * IGN_PI) * this->Uniform<P>();
+        return Vector3<P>(_radius * std::cos(phi), _radius * std::sin(phi),
+            0);
+      }
+
+      /// \brief Draw a point uniformly distributed in a disc in the XY
+      /// plane.
+      /// \param[in] _radius Radius.
+      /// \return Point.
+      private: template<typename P>
+               Vector3<P> Disc(P _radius)
+      {
+        return this->Circle<P>(_radius * std::sqrt(this->Uniform<P>()));
+      }
+
+      /// \brief Engine to draw from.
+      private: Engine &engine;
+    };
+    }
+  }
+}
+
+#endif
@@ -20,6 +20,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/config.hh>
 
@@ -66,6 +67,10 @@ namespace ignition
       /// \brief Forget all previous data.
       public: virtual void Reset();
 
+      /// \brief SignalStats inserts blocks of samples and merges
+      /// statistics directly through their private data.
+      friend class SignalStatsPrivate;
+
 #ifdef _WIN32
 // Disable warning C4251 which is triggered by
 // std::unique_ptr
@@ -174,6 +179,213 @@ namespace ignition
       public: virtual void InsertData(const double _data) override;
     };
 
+    /// \brief Forward declare private data class.
+    class SignalQuantilePrivate;
+
+    /// \class SignalQuantile SignalStats.hh ignition/math/SignalStats.hh
+    /// \brief Computing a quantile (percentile) of a discretely sampled
+    /// signal with bounded memory.
+    ///
+    /// The samples are summarized in a merging t-digest, a sorted set of
+    /// weighted centroids that are kept small near the tails of the
+    /// distribution, where the quantiles of interest usually are. The
+    /// memory used does not grow with the number of samples, and two
+    /// digests can be merged, so quantiles can be computed in parallel.
+    /// \sa https://arxiv.org/abs/1902.04023
+    class IGNITION_MATH_VISIBLE SignalQuantile : public SignalStatistic
+    {
+      /// \brief Constructor
+      /// \param[in] _quantile Quantile to compute, in the range [0, 1].
+      /// For example 0.5 computes the median and 0.99 the 99th percentile.
+      /// Values outside the range are clamped.
+      public: explicit SignalQuantile(double _quantile = 0.5);
+
+      /// \brief Copy constructor
+      /// \param[in] _sq SignalQuantile to copy
+      public: SignalQuantile(const SignalQuantile &_sq);
+
+      /// \brief Destructor
+      public: virtual ~SignalQuantile();
+
+      /// \brief Get the quantile computed by this statistic.
+      /// \return Quantile in the range [0, 1].
+      public: double Quantile() const;
+
+      /// \brief Get the estimated value of the quantile.
+      /// \return Estimated value, or 0 if there is no data.
+      public: virtual double Value() const override;
+
+      /// \brief Get an estimate of any quantile of the inserted data.
+      /// \param[in] _quantile Quantile in the range [0, 1].
+      /// \return Estimated value, or 0 if there is no data.
+      public: double Value(double _quantile) const;
+
+      /// \brief Get a short version of the name of this statistical measure.
+      /// \return "p<N>" if the quantile is a whole percentile N, such as
+      /// "p50" or "p99", otherwise "quantile:<q>", such as
+      /// "quantile:0.999".
+      public: virtual std::string ShortName() const override;
+
+      // Documentation inherited.
+      public: virtual void InsertData(const double _data) override;
+
+      // Documentation inherited.
+      public: virtual void Reset() override;
+
+      /// \brief SignalStats merges the digests of its quantiles.
+      friend class SignalStatsPrivate;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to the private data of the quantile sketch.
+      private: std::unique_ptr<SignalQuantilePrivate> quantileDataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+
+    /// \brief Forward declare private data class.
+    class SignalWindowPrivate;
+
+    /// \class SignalWindowStatistic SignalStats.hh
+    /// ignition/math/SignalStats.hh
+    /// \brief Base class for statistics computed over the most recent
+    /// samples of a signal instead of all samples since Reset().
+    ///
+    /// The samples in the window are kept in a ring buffer that is
+    /// allocated by the constructor, so inserting a sample does not
+    /// allocate and takes amortized constant time regardless of the window
+    /// size. Count() still returns the number of samples inserted since
+    /// Reset(), and windowed statistics cannot be merged.
+    class IGNITION_MATH_VISIBLE SignalWindowStatistic : public SignalStatistic
+    {
+      /// \brief Constructor
+      /// \param[in] _windowSize Number of samples in the window. A value
+      /// of zero is replaced by one.
+      public: explicit SignalWindowStatistic(size_t _windowSize);
+
+      /// \brief Copy constructor
+      /// \param[in] _sws SignalWindowStatistic to copy
+      public: SignalWindowStatistic(const SignalWindowStatistic &_sws);
+
+      /// \brief Destructor
+      public: virtual ~SignalWindowStatistic();
+
+      /// \brief Get the window size.
+      /// \return The maximum number of samples in the window.
+      public: size_t WindowSize() const;
+
+      /// \brief Get the number of samples currently in the window.
+      /// \return The smaller of Count() and WindowSize().
+      public: size_t WindowCount() const;
+
+      // Documentation inherited.
+      public: virtual void Reset() override;
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Pointer to the private data of the window.
+      protected: std::unique_ptr<SignalWindowPrivate> windowDataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+
+    /// \class SignalWindowMaximum SignalStats.hh
+    /// ignition/math/SignalStats.hh
+    /// \brief Computing the maximum value of the most recent samples of a
+    /// discretely sampled signal, using a monotonic queue.
+    class IGNITION_MATH_VISIBLE SignalWindowMaximum
+      : public SignalWindowStatistic
+    {
+      /// \brief Constructor
+      /// \param[in] _windowSize Number of samples in the window.
+      public: explicit SignalWindowMaximum(size_t _windowSize);
+
+      // Documentation inherited.
+      public: virtual double Value() const override;
+
+      /// \brief Get a short version of the name of this statistical measure.
+      /// \return "windowMax:<N>", where N is the window size.
+      public: virtual std::string ShortName() const override;
+
+      // Documentation inherited.
+      public: virtual void InsertData(const double _data) override;
+    };
+
+    /// \class SignalWindowMean SignalStats.hh ignition/math/SignalStats.hh
+    /// \brief Computing the mean value of the most recent samples of a
+    /// discretely sampled signal, using a running sum.
+    class IGNITION_MATH_VISIBLE SignalWindowMean : public SignalWindowStatistic
+    {
+      /// \brief Constructor
+      /// \param[in] _windowSize Number of samples in the window.
+      public: explicit SignalWindowMean(size_t _windowSize);
+
+      // Documentation inherited.
+      public: virtual double Value() const override;
+
+      /// \brief Get a short version of the name of this statistical measure.
+      /// \return "windowMean:<N>", where N is the window size.
+      public: virtual std::string ShortName() const override;
+
+      // Documentation inherited.
+      public: virtual void InsertData(const double _data) override;
+    };
+
+    /// \class SignalWindowMinimum SignalStats.hh
+    /// ignition/math/SignalStats.hh
+    /// \brief Computing the minimum value of the most recent samples of a
+    /// discretely sampled signal, using a monotonic queue.
+    class IGNITION_MATH_VISIBLE SignalWindowMinimum
+      : public SignalWindowStatistic
+    {
+      /// \brief Constructor
+      /// \param[in] _windowSize Number of samples in the window.
+      public: explicit SignalWindowMinimum(size_t _windowSize);
+
+      // Documentation inherited.
+      public: virtual double Value() const override;
+
+      /// \brief Get a short version of the name of this statistical measure.
+      /// \return "windowMin:<N>", where N is the window size.
+      public: virtual std::string ShortName() const override;
+
+      // Documentation inherited.
+      public: virtual void InsertData(const double _data) override;
+    };
+
+    /// \class SignalWindowVariance SignalStats.hh
+    /// ignition/math/SignalStats.hh
+    /// \brief Computing the variance of the most recent samples of a
+    /// discretely sampled signal, using a sliding version of the online
+    /// algorithm of SignalVariance.
+    class IGNITION_MATH_VISIBLE SignalWindowVariance
+      : public SignalWindowStatistic
+    {
+      /// \brief Constructor
+      /// \param[in] _windowSize Number of samples in the window.
+      public: explicit SignalWindowVariance(size_t _windowSize);
+
+      // Documentation inherited.
+      public: virtual double Value() const override;
+
+      /// \brief Get a short version of the name of this statistical measure.
+      /// \return "windowVar:<N>", where N is the window size.
+      public: virtual std::string ShortName() const override;
+
+      // Documentation inherited.
+      public: virtual void InsertData(const double _data) override;
+    };
+
     /// \brief Forward declare private data class.
     class SignalStatsPrivate;
 
@@ -208,12 +420,48 @@ namespace ignition
       /// \param[in] _data New signal data point.
       public: void InsertData(const double _data);
 
+      /// \brief Add a block of samples to the statistical measures.
+      /// This is equivalent to calling InsertData(const double) for each
+      /// sample, but makes a single call into each statistic.
+      /// \param[in] _data New signal data points.
+      public: void InsertData(const std::vector<double> &_data);
+
+      /// \brief Add a block of samples to the statistical measures using
+      /// multiple threads. The block is split in contiguous ranges that
+      /// are processed by separate SignalStats and merged into this one in
+      /// order, so the result does not depend on thread scheduling.
+      /// All statistics must support Merge.
+      /// \param[in] _data New signal data points.
+      /// \param[in] _threadCount Number of threads to use. A value of zero
+      /// uses std::thread::hardware_concurrency().
+      /// \return True if the data was inserted, false if a statistic does
+      /// not support merging. In that case the data is inserted serially.
+      public: bool InsertDataParallel(const std::vector<double> &_data,
+                  unsigned int _threadCount = 0);
+
+      /// \brief Combine the data of another SignalStats into this one.
+      /// Every statistic of this object is merged with the statistic of
+      /// _other that has the same short name.
+      /// \param[in] _other SignalStats to merge into this one.
+      /// \return True if the statistics were merged, false if _other does
+      /// not contain the same statistics or one of them does not support
+      /// merging. Nothing is modified when false is returned.
+      public: bool Merge(const SignalStats &_other);
+
       /// \brief Add a new type of statistic.
       /// \param[in] _name Short name of new statistic.
       /// Valid values include:
+      ///  "max"
       ///  "maxAbs"
       ///  "mean"
+      ///  "min"
       ///  "rms"
+      ///  "var"
+      ///  "p<N>", the N-th percentile, for example "p50" or "p99"
+      ///  "quantile:<q>", the q quantile, for example "quantile:0.999"
+      ///  "windowMax:<N>", "windowMean:<N>", "windowMin:<N>" and
+      ///  "windowVar:<N>", computed over the last N samples, for example
+      ///  "windowMean:100"
       /// \return True if statistic was successfully added,
       /// false if name was not recognized or had already
       /// been inserted.
@@ -0,0 +1,485 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_STATICSIGNALSTATS_HH_
+#define IGNITION_MATH_STATICSIGNALSTATS_HH_
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <ignition/math/Helpers.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    /// \struct SignalStatsState StaticSignalStats.hh
+    /// ignition/math/StaticSignalStats.hh
+    /// \brief Plain data shared by all statistics of a StaticSignalStats.
+    /// Each statistic only reads and writes the members it needs, so the
+    /// whole state can be copied, zeroed or placed in shared memory as a
+    /// single block.
+    struct SignalStatsState
+    {
+      /// \brief Number of data points inserted since the last reset.
+      size_t count = 0;
+
+      /// \brief Largest data point.
+      double max = 0.0;
+
+      /// \brief Smallest data point.
+      double min = 0.0;
+
+      /// \brief Sum of the data points.
+      double sum = 0.0;
+
+      /// \brief Sum of the squared data points.
+      double sumSquares = 0.0;
+
+      /// \brief Largest absolute value of the data points.
+      double maxAbs = 0.0;
+
+      /// \brief Running mean used by the variance computation.
+      double mean = 0.0;
+
+      /// \brief Running sum of squared differences from the mean.
+      double m2 = 0.0;
+    };
+
+    /// \brief Statistics that can be combined in a StaticSignalStats.
+    /// Each statistic provides the same values and short names as its
+    /// SignalStatistic counterpart in SignalStats.hh. The InsertData and
+    /// Merge functions are called before SignalStatsState::count is
+    /// updated.
+    namespace stats
+    {
+      /// \brief Maximum value, see SignalMaximum.
+      struct Maximum
+      {
+        /// \brief Get the short name of the statistic.
+        /// \return "max"
+        static constexpr const char *ShortName()
+        {
+          return "max";
+        }
+
+        /// \brief Add a new sample to the state.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _data New signal data point.
+        static void InsertData(SignalStatsState &_state, const double _data)
+        {
+          if (_state.count == 0 || _data > _state.max)
+            _state.max = _data;
+        }
+
+        /// \brief Merge the state of another set of samples.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _other State to merge into _state.
+        static void Merge(SignalStatsState &_state,
+            const SignalStatsState &_other)
+        {
+          if (_other.count > 0 &&
+              (_state.count == 0 || _other.max > _state.max))
+          {
+            _state.max = _other.max;
+          }
+        }
+
+        /// \brief Get the value of the statistic.
+        /// \param[in] _state State to read.
+        /// \return Current value of the statistic.
+        static double Value(const SignalStatsState &_state)
+        {
+          return _state.max;
+        }
+      };
+
+      /// \brief Mean value, see SignalMean.
+      struct Mean
+      {
+        /// \brief Get the short name of the statistic.
+        /// \return "mean"
+        static constexpr const char *ShortName()
+        {
+          return "mean";
+        }
+
+        /// \brief Add a new sample to the state.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _data New signal data point.
+        static void InsertData(SignalStatsState &_state, const double _data)
+        {
+          _state.sum += _data;
+        }
+
+        /// \brief Merge the state of another set of samples.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _other State to merge into _state.
+        static void Merge(SignalStatsState &_state,
+            const SignalStatsState &_other)
+        {
+          _state.sum += _other.sum;
+        }
+
+        /// \brief Get the value of the statistic.
+        /// \param[in] _state State to read.
+        /// \return Current value of the statistic.
+        static double Value(const SignalStatsState &_state)
+        {
+          if (_state.count == 0)
+            return 0;
+          return _state.sum / _state.count;
+        }
+      };
+
+      /// \brief Minimum value, see SignalMinimum.
+      struct Minimum
+      {
+        /// \brief Get the short name of the statistic.
+        /// \return "min"
+        static constexpr const char *ShortName()
+        {
+          return "min";
+        }
+
+        /// \brief Add a new sample to the state.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _data New signal data point.
+        static void InsertData(SignalStatsState &_state, const double _data)
+        {
+          if (_state.count == 0 || _data < _state.min)
+            _state.min = _data;
+        }
+
+        /// \brief Merge the state of another set of samples.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _other State to merge into _state.
+        static void Merge(SignalStatsState &_state,
+            const SignalStatsState &_other)
+        {
+          if (_other.count > 0 &&
+              (_state.count == 0 || _other.min < _state.min))
+          {
+            _state.min = _other.min;
+          }
+        }
+
+        /// \brief Get the value of the statistic.
+        /// \param[in] _state State to read.
+        /// \return Current value of the statistic.
+        static double Value(const SignalStatsState &_state)
+        {
+          return _state.min;
+        }
+      };
+
+      /// \brief Root mean square, see SignalRootMeanSquare.
+      struct RootMeanSquare
+      {
+        /// \brief Get the short name of the statistic.
+        /// \return "rms"
+        static constexpr const char *ShortName()
+        {
+          return "rms";
+        }
+
+        /// \brief Add a new sample to the state.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _data New signal data point.
+        static void InsertData(SignalStatsState &_state, const double _data)
+        {
+          _state.sumSquares += _data * _data;
+        }
+
+        /// \brief Merge the state of another set of samples.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _other State to merge into _state.
+        static void Merge(SignalStatsState &_state,
+            const SignalStatsState &_other)
+        {
+          _state.sumSquares += _other.sumSquares;
+        }
+
+        /// \brief Get the value of the statistic.
+        /// \param[in] _state State to read.
+        /// \return Current value of the statistic.
+        static double Value(const SignalStatsState &_state)
+        {
+          if (_state.count == 0)
+            return 0;
+          return std::sqrt(_state.sumSquares / _state.count);
+        }
+      };
+
+      /// \brief Maximum absolute value, see SignalMaxAbsoluteValue.
+      struct MaxAbsoluteValue
+      {
+        /// \brief Get the short name of the statistic.
+        /// \return "maxAbs"
+        static constexpr const char *ShortName()
+        {
+          return "maxAbs";
+        }
+
+        /// \brief Add a new sample to the state.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _data New signal data point.
+        static void InsertData(SignalStatsState &_state, const double _data)
+        {
+          const double absData = std::abs(_data);
+          if (absData > _state.maxAbs)
+            _state.maxAbs = absData;
+        }
+
+        /// \brief Merge the state of another set of samples.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _other State to merge into _state.
+        static void Merge(SignalStatsState &_state,
+            const SignalStatsState &_other)
+        {
+          if (_other.maxAbs > _state.maxAbs)
+            _state.maxAbs = _other.maxAbs;
+        }
+
+        /// \brief Get the value of the statistic.
+        /// \param[in] _state State to read.
+        /// \return Current value of the statistic.
+        static double Value(const SignalStatsState &_state)
+        {
+          return _state.maxAbs;
+        }
+      };
+
+      /// \brief Sample variance, see SignalVariance.
+      struct Variance
+      {
+        /// \brief Get the short name of the statistic.
+        /// \return "var"
+        static constexpr const char *ShortName()
+        {
+          return "var";
+        }
+
+        /// \brief Add a new sample to the state.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _data New signal data point.
+        static void InsertData(SignalStatsState &_state, const double _data)
+        {
+          // Same online algorithm as SignalVariance::InsertData
+          const double delta = _data - _state.mean;
+          _state.mean += delta / (_state.count + 1);
+          _state.m2 += delta * (_data - _state.mean);
+        }
+
+        /// \brief Merge the state of another set of samples.
+        /// \param[in, out] _state State to update.
+        /// \param[in] _other State to merge into _state.
+        static void Merge(SignalStatsState &_state,
+            const SignalStatsState &_other)
+        {
+          // Parallel algorithm of Chan et al., see SignalVariance::Merge
+          if (_other.count == 0)
+            return;
+          const double countA = static_cast<double>(_state.count);
+          const double countB = static_cast<double>(_other.count);
+          const double count = countA + countB;
+          const double delta = _other.mean - _state.mean;
+          _state.mean += delta * countB / count;
+          _state.m2 += _other.m2 + delta * delta * countA * countB / count;
+        }
+
+        /// \brief Get the value of the statistic.
+        /// \param[in] _state State to read.
+        /// \return Current value of the statistic.
+        static double Value(const SignalStatsState &_state)
+        {
+          if (_state.count < 2)
+            return 0.0;
+          return _state.m2 / (_state.count - 1);
+        }
+      };
+    }
+
+    /// \class StaticSignalStats StaticSignalStats.hh
+    /// ignition/math/StaticSignalStats.hh
+    /// \brief Collection of statistics for a scalar signal, selected at
+    /// compile time.
+    ///
+    /// This computes the same values as SignalStats, but the set of
+    /// statistics is a template parameter pack instead of a vector of
+    /// heap-allocated SignalStatistic objects. InsertData is a single
+    /// inlined update of one plain SignalStatsState, and values can be
+    /// read without allocating either by type or by index into the
+    /// parameter pack.
+    ///
+    /// ## Example usage
+    ///
+    /// \code{.cpp}
+    /// StaticSignalStats<stats::Mean, stats::Variance, stats::Maximum> s;
+    /// s.InsertData(1.0);
+    /// s.InsertData(3.0);
+    /// double mean = s.Value<stats::Mean>();
+    /// double var = s.Value(s.Index<stats::Variance>());
+    /// \endcode
+    template<typename... Stats>
+    class StaticSignalStats
+    {
+      static_assert(sizeof...(Stats) > 0,
+          "StaticSignalStats requires at least one statistic");
+
+      /// \brief Number of times statistic S appears in the parameter pack.
+      private: template<typename S>
+               struct Occurrences
+                 : std::integral_constant<size_t,
+                     (0 + ... + std::is_same<S, Stats>::value)>
+      {
+      };
+
+      // A repeated statistic would update the shared state twice per sample
+      static_assert(((Occurrences<Stats>::value == 1) && ...),
+          "Each statistic can appear only once in StaticSignalStats");
+
+      /// \brief Number of statistics.
+      public: static constexpr size_t kCount = sizeof...(Stats);
+
+      /// \brief Default constructor.
+      public: StaticSignalStats() = default;
+
+      /// \brief Constructor from a state, such as one returned by State().
+      /// \param[in] _state State of all statistics.
+      public: explicit StaticSignalStats(const SignalStatsState &_state)
+        : state(_state)
+      {
+      }
+
+      /// \brief Get the index of a statistic in the parameter pack.
+      /// \return Index of statistic S, usable with Value(size_t).
+      public: template<typename S>
+              static constexpr size_t Index()
+      {
+        constexpr bool matches[] = {std::is_same<S, Stats>::value...};
+        for (size_t i = 0; i < kCount; ++i)
+        {
+          if (matches[i])
+            return i;
+        }
+        return kCount;
+      }
+
+      /// \brief Get the short name of each statistic, in the order of the
+      /// parameter pack.
+      /// \return Array of short names.
+      public: static constexpr std::array<const char *, kCount> ShortNames()
+      {
+        return {{Stats::ShortName()...}};
+      }
+
+      /// \brief Get number of data points.
+      /// \return Number of data points.
+      public: size_t Count() const
+      {
+        return this->state.count;
+      }
+
+      /// \brief Add a new sample to all statistics.
+      /// \param[in] _data New signal data point.
+      public: void InsertData(const double _data)
+      {
+        (Stats::InsertData(this->state, _data), ...);
+        ++this->state.count;
+      }
+
+      /// \brief Combine the data of another StaticSignalStats with the
+      /// same statistics into this one.
+      /// \param[in] _other Statistics to merge into this one.
+      public: void Merge(const StaticSignalStats &_other)
+      {
+        // Copy the other state first in case _other is this object
+        const SignalStatsState other = _other.state;
+        (Stats::Merge(this->state, other), ...);
+        this->state.count += other.count;
+      }
+
+      /// \brief Get the current value of one statistic.
+      /// \return Current value of statistic S.
+      public: template<typename S>
+              double Value() const
+      {
+        static_assert(Index<S>() < kCount,
+            "Statistic is not part of this StaticSignalStats");
+        return S::Value(this->state);
+      }
+
+      /// \brief Get the current value of a statistic by index.
+      /// \param[in] _index Index of the statistic in the parameter pack.
+      /// \return Current value of the statistic, or NaN if _index is out
+      /// of range.
+      public: double Value(const size_t _index) const
+      {
+        using ValueFn = double (*)(const SignalStatsState &);
+        static constexpr ValueFn kValueFns[] = {&Stats::Value...};
+        if (_index >= kCount)
+          return NAN_D;
+        return kValueFns[_index](this->state);
+      }
+
+      /// \brief Get the current values of all statistics, in the order of
+      /// the parameter pack.
+      /// \return Array of values.
+      public: std::array<double, kCount> Values() const
+      {
+        return {{Stats::Value(this->state)...}};
+      }
+
+      /// \brief Get the current values of each statistical measure,
+      /// stored in a map using the short name as the key. This allocates
+      /// and is provided for compatibility with SignalStats::Map.
+      /// \return Map with short name of each statistic as key
+      /// and value of statistic as the value.
+      public: std::map<std::string, double> Map() const
+      {
+        std::map<std::string, double> map;
+        ((map[Stats::ShortName()] = Stats::Value(this->state)), ...);
+        return map;
+      }
+
+      /// \brief Get the underlying state.
+      /// \return State of all statistics.
+      public: const SignalStatsState &State() const
+      {
+        return this->state;
+      }
+
+      /// \brief Forget all previous data.
+      public: void Reset()
+      {
+        this->state = SignalStatsState();
+      }
+
+      /// \brief State of all statistics.
+      private: SignalStatsState state;
+    };
+    }
+  }
+}
+#endif
@@ -18,6 +18,7 @@
 #define IGNITION_MATH_VECTOR3STATS_HH_
 
 #include <string>
+#include <vector>
 #include <ignition/math/Helpers.hh>
 #include <ignition/math/SignalStats.hh>
 #include <ignition/math/Vector3.hh>
@@ -47,6 +48,32 @@ namespace ignition
       /// \param[in] _data New signal data point.
       public: void InsertData(const Vector3d &_data);
 
+      /// \brief Add a block of samples to the statistical measures.
+      /// The components and magnitude of the samples are computed in a
+      /// single pass and passed to the X, Y, Z and magnitude statistics
+      /// in blocks.
+      /// \param[in] _data New signal data points.
+      public: void InsertData(const std::vector<Vector3d> &_data);
+
+      /// \brief Add a block of samples to the statistical measures using
+      /// multiple threads.
+      /// \param[in] _data New signal data points.
+      /// \param[in] _threadCount Number of threads to use. A value of zero
+      /// uses std::thread::hardware_concurrency().
+      /// \return True if the data was inserted, false if a statistic does
+      /// not support merging. In that case the data is inserted serially.
+      /// \sa SignalStats::InsertDataParallel
+      public: bool InsertDataParallel(const std::vector<Vector3d> &_data,
+                  unsigned int _threadCount = 0);
+
+      /// \brief Combine the data of another Vector3Stats into this one.
+      /// \param[in] _other Vector3Stats to merge into this one.
+      /// \return True if the statistics were merged, false if _other does
+      /// not contain the same statistics or one of them does not support
+      /// merging. Nothing is modified when false is returned.
+      /// \sa SignalStats::Merge
+      public: bool Merge(const Vector3Stats &_other);
+
       /// \brief Add a new type of statistic.
       /// \param[in] _name Short name of new statistic.
       /// Valid values include:
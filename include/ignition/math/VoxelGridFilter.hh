@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_VOXELGRIDFILTER_HH_
+#define IGNITION_MATH_VOXELGRIDFILTER_HH_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <ignition/math/Export.hh>
+#include <ignition/math/Vector3.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    // Inline bracket to help doxygen filtering.
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE {
+    //
+    // Forward declare private data
+    class VoxelGridFilterPrivate;
+
+    /// \class VoxelGridFilter VoxelGridFilter.hh
+    /// ignition/math/VoxelGridFilter.hh
+    /// \brief Downsample a point cloud to one point per occupied voxel.
+    ///
+    /// Voxels are cubes of VoxelSize() aligned with the origin, so the
+    /// voxel of a point does not depend on the other points and
+    /// successive scans share the same voxels. Points are sorted by voxel
+    /// with a radix sort on packed integer keys, which runs on several
+    /// threads, see Threads(unsigned int). Output points are ordered by
+    /// voxel, along z first, then y, then x, and do not depend on the
+    /// number of threads.
+    class IGNITION_MATH_VISIBLE VoxelGridFilter
+    {
+      /// \brief Point kept for each voxel.
+      public: enum RepresentativeType
+              {
+                /// \brief Centroid of the points of the voxel.
+                CENTROID = 0,
+
+                /// \brief First point of the voxel in the input.
+                FIRST = 1,
+
+                /// \brief Point of the voxel closest to its center, the
+                /// first in the input in case of a tie.
+                NEAREST = 2
+              };
+
+      /// \brief Constructor.
+      /// \param[in] _voxelSize Size of the voxels.
+      /// \param[in] _representative Point kept for each voxel.
+      public: explicit VoxelGridFilter(double _voxelSize,
+                  RepresentativeType _representative = CENTROID);
+
+      /// \brief Destructor.
+      public: ~VoxelGridFilter();
+
+      /// \brief Get the size of the voxels.
+      /// \return Size.
+      public: double VoxelSize() const;
+
+      /// \brief Set the size of the voxels.
+      /// \param[in] _voxelSize Size, positive.
+      public: void VoxelSize(double _voxelSize);
+
+      /// \brief Get the point kept for each voxel.
+      /// \return Representative point.
+      public: RepresentativeType Representative() const;
+
+      /// \brief Set the point kept for each voxel.
+      /// \param[in] _representative Representative point.
+      public: void Representative(RepresentativeType _representative);
+
+      /// \brief Set the number of threads used by Filter. The default is
+      /// one.
+      /// \param[in] _threads Number of threads, or zero to use one per
+      /// hardware thread.
+      public: void Threads(unsigned int _threads);
+
+      /// \brief Get the number of threads used by Filter.
+      /// \return Number of threads.
+      public: unsigned int Threads() const;
+
+      /// \brief Downsample points.
+      /// \param[in] _points Points.
+      /// \param[out] _output One point per occupied voxel.
+      /// \return False if VoxelSize() is not a positive finite number, or
+      /// if the points span more than 2^63 voxels.
+      public: bool Filter(const std::vector<Vector3d> &_points,
+                  std::vector<Vector3d> &_output);
+
+      /// \brief Downsample caller-owned points, which are not copied.
+      /// \param[in] _points Array of _count points. Points that are not
+      /// finite are ignored.
+      /// \param[in] _count Number of points.
+      /// \param[out] _output One point per occupied voxel.
+      /// \return False if the points are null, if VoxelSize() is not a
+      /// positive finite number, or if the points span more than 2^63
+      /// voxels.
+      public: bool Filter(const Vector3d *_points, size_t _count,
+                  std::vector<Vector3d> &_output);
+
+#ifdef _WIN32
+// Disable warning C4251 which is triggered by
+// std::unique_ptr
+#pragma warning(push)
+#pragma warning(disable: 4251)
+#endif
+      /// \brief Private data pointer.
+      private: std::unique_ptr<VoxelGridFilterPrivate> dataPtr;
+#ifdef _WIN32
+#pragma warning(pop)
+#endif
+    };
+    }
+  }
+}
+#endif
@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_CHUNKPOOL_HH_
+#define IGNITION_MATH_CHUNKPOOL_HH_
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /// \internal
+    /// \brief A fixed set of threads that run a function on numbered chunks
+    /// of work. The calling thread takes part, so a pool of one thread runs
+    /// everything on the calling thread.
+    class ChunkPool
+    {
+      /// \brief Constructor.
+      /// \param[in] _threads Number of threads, including the caller.
+      public: explicit ChunkPool(unsigned int _threads)
+      {
+        for (unsigned int i = 1; i < _threads; ++i)
+          this->workers.emplace_back([this] {this->Loop();});
+      }
+
+      /// \brief Destructor. Stops and joins the threads.
+      public: ~ChunkPool()
+      {
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          this->stop = true;
+        }
+        this->wake.notify_all();
+        for (std::thread &worker : this->workers)
+          worker.join();
+      }
+
+      /// \brief Run a function on each chunk, and return when all are done.
+      /// Chunks may run in any order and on any thread.
+      /// \param[in] _chunks Number of chunks.
+      /// \param[in] _function Function called with each chunk index.
+      public: void Run(size_t _chunks,
+                  const std::function<void(size_t)> &_function)
+      {
+        if (this->workers.empty() || _chunks <= 1)
+        {
+          for (size_t c = 0; c < _chunks; ++c)
+            _function(c);
+          return;
+        }
+
+        {
+          std::lock_guard<std::mutex> lock(this->mutex);
+          this->function = &_function;
+          this->chunks = _chunks;
+          this->next = 0;
+          this->pending = this->workers.size();
+          ++this->generation;
+        }
+        this->wake.notify_all();
+        this->Work();
+
+        std::unique_lock<std::mutex> lock(this->mutex);
+        this->done.wait(lock, [this] {return this->pending == 0;});
+      }
+
+      /// \brief Run chunks until none is left.
+      private: void Work()
+      {
+        for (size_t c = this->next++; c < this->chunks; c = this->next++)
+          (*this->function)(c);
+      }
+
+      /// \brief Main loop of the threads.
+      private: void Loop()
+      {
+        size_t seen = 0;
+        std::unique_lock<std::mutex> lock(this->mutex);
+        while (true)
+        {
+          this->wake.wait(lock, [&] {
+              return this->stop || this->generation != seen;});
+          if (this->stop)
+            return;
+          seen = this->generation;
+
+          lock.unlock();
+          this->Work();
+          lock.lock();
+          if (--this->pending == 0)
+            this->done.notify_one();
+        }
+      }
+
+      /// \brief Threads other than the caller.
+      private: std::vector<std::thread> workers;
+
+      /// \brief Protects the fields below, except next.
+      private: std::mutex mutex;
+
+      /// \brief Signals a new run or a stop to the threads.
+      private: std::condition_variable wake;
+
+      /// \brief Signals that all threads finished the current run.
+      private: std::condition_variable done;
+
+      /// \brief Function of the current run.
+      private: const std::function<void(size_t)> *function = nullptr;
+
+      /// \brief Number of chunks of the current run.
+      private: size_t chunks = 0;
+
+      /// \brief Next chunk to run.
+      private: std::atomic<size_t> next{0};
+
+      /// \brief Number of threads still working on the current run.
+      private: size_t pending = 0;
+
+      /// \brief Number of runs so far.
+      private: size_t generation = 0;
+
+      /// \brief True when the threads must exit.
+      private: bool stop = false;
+    };
+    }
+  }
+}
+#endif
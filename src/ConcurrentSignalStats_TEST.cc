@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+#include "ignition/math/ConcurrentSignalStats.hh"
+
+using namespace ignition;
+
+using Stats = math::ConcurrentSignalStats<math::stats::Mean,
+      math::stats::Maximum, math::stats::Minimum, math::stats::Variance>;
+
+/////////////////////////////////////////////////
+TEST(ConcurrentSignalStatsTest, SingleWriter)
+{
+  Stats stats;
+  EXPECT_EQ(stats.Writers(), 1u);
+  EXPECT_EQ(stats.Count(), 0u);
+  EXPECT_FALSE(stats.InsertData(1, 1.0));
+
+  EXPECT_TRUE(stats.InsertData(0, 1.0));
+  EXPECT_TRUE(stats.InsertData(0, {-2.0, 4.0}));
+  EXPECT_EQ(stats.Count(), 3u);
+
+  auto snapshot = stats.Snapshot();
+  EXPECT_DOUBLE_EQ(snapshot.Value<math::stats::Mean>(), 1.0);
+  EXPECT_DOUBLE_EQ(snapshot.Value<math::stats::Variance>(), 9.0);
+  EXPECT_DOUBLE_EQ(snapshot.Value<math::stats::Maximum>(), 4.0);
+  EXPECT_DOUBLE_EQ(snapshot.Value<math::stats::Minimum>(), -2.0);
+  EXPECT_DOUBLE_EQ(stats.Map()["mean"], 1.0);
+
+  EXPECT_EQ(stats.Snapshot(0).Count(), 3u);
+  EXPECT_EQ(stats.Snapshot(1).Count(), 0u);
+
+  stats.Reset();
+  EXPECT_EQ(stats.Count(), 0u);
+
+  Stats zero(0);
+  EXPECT_EQ(zero.Writers(), 1u);
+}
+
+/////////////////////////////////////////////////
+TEST(ConcurrentSignalStatsTest, ConcurrentWriters)
+{
+  const unsigned int writers = 4;
+  const int samples = 20000;
+  Stats stats(writers);
+
+  // Writer w inserts alternating values w and -w, so every consistent
+  // snapshot has a mean close to zero and a bounded range.
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistent{0};
+  std::thread reader([&]()
+  {
+    while (!done)
+    {
+      for (unsigned int w = 0; w < writers; ++w)
+      {
+        auto snapshot = stats.Snapshot(w);
+        const size_t count = snapshot.Count();
+        const double mean = snapshot.Value<math::stats::Mean>();
+        const double expectedMean = (count % 2 == 1) ? w / double(count) : 0;
+        if (std::abs(mean - expectedMean) > 1e-9)
+          ++inconsistent;
+      }
+      auto all = stats.Snapshot();
+      if (all.Count() > 0 && all.Value<math::stats::Maximum>() > writers)
+        ++inconsistent;
+    }
+  });
+
+  std::vector<std::thread> threads;
+  for (unsigned int w = 0; w < writers; ++w)
+  {
+    threads.emplace_back([&stats, w, samples]()
+    {
+      for (int i = 0; i < samples; ++i)
+        stats.InsertData(w, (i % 2 == 0) ? double(w) : -double(w));
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(inconsistent, 0);
+
+  math::StaticSignalStats<math::stats::Mean, math::stats::Maximum,
+      math::stats::Minimum, math::stats::Variance> serial;
+  for (unsigned int w = 0; w < writers; ++w)
+  {
+    for (int i = 0; i < samples; ++i)
+      serial.InsertData((i % 2 == 0) ? double(w) : -double(w));
+  }
+
+  auto snapshot = stats.Snapshot();
+  EXPECT_EQ(snapshot.Count(), serial.Count());
+  for (size_t i = 0; i < serial.kCount; ++i)
+    EXPECT_NEAR(snapshot.Value(i), serial.Value(i), 1e-9);
+}
@@ -0,0 +1,284 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <iostream>
+
+#include "ignition/math/ConstantVelocityTrackerBank.hh"
+
+using namespace ignition;
+using namespace math;
+
+/// \brief Private data for the ConstantVelocityTrackerBank class. Each
+/// array holds three values per track, one per axis, at index
+/// 3 * track + axis.
+class ignition::math::ConstantVelocityTrackerBankPrivate
+{
+  /// \brief Correct one axis of one track with a position measurement.
+  /// The measurement is ignored if both the position variance and the
+  /// measurement noise are zero, since the position is already exact.
+  /// \param[in] _k Array index of the track axis.
+  /// \param[in] _z Measured position.
+  public: void Correct(size_t _k, double _z)
+  {
+    const double s = this->pp[_k] + this->measurementNoise;
+    if (s <= 0)
+      return;
+
+    const double gainPos = this->pp[_k] / s;
+    const double gainVel = this->pv[_k] / s;
+    const double residual = _z - this->pos[_k];
+
+    this->pos[_k] += gainPos * residual;
+    this->vel[_k] += gainVel * residual;
+    this->vv[_k] -= gainVel * this->pv[_k];
+    this->pv[_k] -= gainPos * this->pv[_k];
+    this->pp[_k] -= gainPos * this->pp[_k];
+  }
+
+  /// \brief Spectral density of the acceleration noise.
+  public: double processNoise = 1.0;
+
+  /// \brief Variance of the position measurements.
+  public: double measurementNoise = 1.0;
+
+  /// \brief Positions.
+  public: std::vector<double> pos;
+
+  /// \brief Velocities.
+  public: std::vector<double> vel;
+
+  /// \brief Position variances.
+  public: std::vector<double> pp;
+
+  /// \brief Position-velocity covariances.
+  public: std::vector<double> pv;
+
+  /// \brief Velocity variances.
+  public: std::vector<double> vv;
+};
+
+//////////////////////////////////////////////////
+ConstantVelocityTrackerBank::ConstantVelocityTrackerBank()
+  : dataPtr(new ConstantVelocityTrackerBankPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+ConstantVelocityTrackerBank::ConstantVelocityTrackerBank(double _processNoise,
+    double _measurementNoise)
+  : dataPtr(new ConstantVelocityTrackerBankPrivate)
+{
+  this->SetProcessNoise(_processNoise);
+  this->SetMeasurementNoise(_measurementNoise);
+}
+
+//////////////////////////////////////////////////
+ConstantVelocityTrackerBank::~ConstantVelocityTrackerBank()
+{
+}
+
+//////////////////////////////////////////////////
+double ConstantVelocityTrackerBank::ProcessNoise() const
+{
+  return this->dataPtr->processNoise;
+}
+
+//////////////////////////////////////////////////
+void ConstantVelocityTrackerBank::SetProcessNoise(double _noise)
+{
+  this->dataPtr->processNoise = std::max(0.0, _noise);
+}
+
+//////////////////////////////////////////////////
+double ConstantVelocityTrackerBank::MeasurementNoise() const
+{
+  return this->dataPtr->measurementNoise;
+}
+
+//////////////////////////////////////////////////
+void ConstantVelocityTrackerBank::SetMeasurementNoise(double _noise)
+{
+  this->dataPtr->measurementNoise = std::max(0.0, _noise);
+}
+
+//////////////////////////////////////////////////
+size_t ConstantVelocityTrackerBank::Count() const
+{
+  return this->dataPtr->pos.size() / 3;
+}
+
+//////////////////////////////////////////////////
+size_t ConstantVelocityTrackerBank::AddTrack(const Vector3d &_position,
+    const Vector3d &_velocity, double _positionVariance,
+    double _velocityVariance)
+{
+  for (int a = 0; a < 3; ++a)
+  {
+    this->dataPtr->pos.push_back(_position[a]);
+    this->dataPtr->vel.push_back(_velocity[a]);
+    this->dataPtr->pp.push_back(_positionVariance);
+    this->dataPtr->pv.push_back(0.0);
+    this->dataPtr->vv.push_back(_velocityVariance);
+  }
+  return this->Count() - 1;
+}
+
+//////////////////////////////////////////////////
+bool ConstantVelocityTrackerBank::RemoveTrack(size_t _index)
+{
+  const size_t count = this->Count();
+  if (_index >= count)
+    return false;
+
+  for (auto *values : {&this->dataPtr->pos, &this->dataPtr->vel,
+      &this->dataPtr->pp, &this->dataPtr->pv, &this->dataPtr->vv})
+  {
+    std::copy(values->end() - 3, values->end(),
+        values->begin() + 3 * _index);
+    values->resize(3 * (count - 1));
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+void ConstantVelocityTrackerBank::Clear()
+{
+  this->dataPtr->pos.clear();
+  this->dataPtr->vel.clear();
+  this->dataPtr->pp.clear();
+  this->dataPtr->pv.clear();
+  this->dataPtr->vv.clear();
+}
+
+//////////////////////////////////////////////////
+void ConstantVelocityTrackerBank::Predict(double _dt)
+{
+  // Per axis, F = [1 dt; 0 1] and the discretized white noise
+  // acceleration gives Q = q [dt^3/3 dt^2/2; dt^2/2 dt].
+  const double q = this->dataPtr->processNoise;
+  const double qPP = q * _dt * _dt * _dt / 3.0;
+  const double qPV = q * _dt * _dt / 2.0;
+  const double qVV = q * _dt;
+
+  const size_t n = this->dataPtr->pos.size();
+  double *pos = this->dataPtr->pos.data();
+  const double *vel = this->dataPtr->vel.data();
+  double *pp = this->dataPtr->pp.data();
+  double *pv = this->dataPtr->pv.data();
+  double *vv = this->dataPtr->vv.data();
+  for (size_t k = 0; k < n; ++k)
+  {
+    pos[k] += _dt * vel[k];
+    pp[k] += _dt * (2.0 * pv[k] + _dt * vv[k]) + qPP;
+    pv[k] += _dt * vv[k] + qPV;
+    vv[k] += qVV;
+  }
+}
+
+//////////////////////////////////////////////////
+bool ConstantVelocityTrackerBank::Update(
+    const std::vector<Vector3d> &_positions)
+{
+  if (_positions.size() != this->Count())
+  {
+    std::cerr << "Expected " << this->Count() << " positions, got "
+              << _positions.size() << std::endl;
+    return false;
+  }
+
+  for (size_t i = 0; i < _positions.size(); ++i)
+  {
+    for (int a = 0; a < 3; ++a)
+      this->dataPtr->Correct(3 * i + a, _positions[i][a]);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool ConstantVelocityTrackerBank::Update(const std::vector<size_t> &_indices,
+    const std::vector<Vector3d> &_positions)
+{
+  if (_indices.size() != _positions.size())
+  {
+    std::cerr << "Got " << _indices.size() << " indices and "
+              << _positions.size() << " positions" << std::endl;
+    return false;
+  }
+
+  const size_t count = this->Count();
+  for (const size_t index : _indices)
+  {
+    if (index >= count)
+    {
+      std::cerr << "Track index " << index << " is out of range" << std::endl;
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < _indices.size(); ++i)
+  {
+    for (int a = 0; a < 3; ++a)
+      this->dataPtr->Correct(3 * _indices[i] + a, _positions[i][a]);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+Vector3d ConstantVelocityTrackerBank::Position(size_t _index) const
+{
+  if (_index >= this->Count())
+    return Vector3d::NaN;
+  const double *v = &this->dataPtr->pos[3 * _index];
+  return Vector3d(v[0], v[1], v[2]);
+}
+
+//////////////////////////////////////////////////
+Vector3d ConstantVelocityTrackerBank::Velocity(size_t _index) const
+{
+  if (_index >= this->Count())
+    return Vector3d::NaN;
+  const double *v = &this->dataPtr->vel[3 * _index];
+  return Vector3d(v[0], v[1], v[2]);
+}
+
+//////////////////////////////////////////////////
+Vector3d ConstantVelocityTrackerBank::PositionVariance(size_t _index) const
+{
+  if (_index >= this->Count())
+    return Vector3d::NaN;
+  const double *v = &this->dataPtr->pp[3 * _index];
+  return Vector3d(v[0], v[1], v[2]);
+}
+
+//////////////////////////////////////////////////
+Vector3d ConstantVelocityTrackerBank::VelocityVariance(size_t _index) const
+{
+  if (_index >= this->Count())
+    return Vector3d::NaN;
+  const double *v = &this->dataPtr->vv[3 * _index];
+  return Vector3d(v[0], v[1], v[2]);
+}
+
+//////////////////////////////////////////////////
+Vector3d ConstantVelocityTrackerBank::PositionVelocityCovariance(
+    size_t _index) const
+{
+  if (_index >= this->Count())
+    return Vector3d::NaN;
+  const double *v = &this->dataPtr->pv[3 * _index];
+  return Vector3d(v[0], v[1], v[2]);
+}
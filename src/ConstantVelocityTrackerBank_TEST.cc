@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/ConstantVelocityTrackerBank.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(ConstantVelocityTrackerBankTest, Tracks)
+{
+  math::ConstantVelocityTrackerBank bank;
+  EXPECT_DOUBLE_EQ(bank.ProcessNoise(), 1.0);
+  EXPECT_DOUBLE_EQ(bank.MeasurementNoise(), 1.0);
+  EXPECT_EQ(bank.Count(), 0u);
+
+  bank.SetProcessNoise(-1.0);
+  EXPECT_DOUBLE_EQ(bank.ProcessNoise(), 0.0);
+  bank.SetMeasurementNoise(0.5);
+  EXPECT_DOUBLE_EQ(bank.MeasurementNoise(), 0.5);
+
+  EXPECT_EQ(bank.AddTrack(math::Vector3d(1, 2, 3)), 0u);
+  EXPECT_EQ(bank.AddTrack(math::Vector3d(4, 5, 6), math::Vector3d(1, 0, 0),
+      2.0, 3.0), 1u);
+  EXPECT_EQ(bank.AddTrack(math::Vector3d(7, 8, 9)), 2u);
+  EXPECT_EQ(bank.Count(), 3u);
+
+  EXPECT_EQ(bank.Position(1), math::Vector3d(4, 5, 6));
+  EXPECT_EQ(bank.Velocity(1), math::Vector3d(1, 0, 0));
+  EXPECT_EQ(bank.PositionVariance(1), math::Vector3d(2, 2, 2));
+  EXPECT_EQ(bank.VelocityVariance(1), math::Vector3d(3, 3, 3));
+  EXPECT_EQ(bank.PositionVelocityCovariance(1), math::Vector3d::Zero);
+  EXPECT_TRUE(std::isnan(bank.Position(3).X()));
+  EXPECT_TRUE(std::isnan(bank.Velocity(3).X()));
+
+  // Without process noise, prediction moves along the velocity
+  bank.Predict(2.0);
+  EXPECT_EQ(bank.Position(1), math::Vector3d(6, 5, 6));
+  EXPECT_EQ(bank.PositionVariance(1), math::Vector3d(14, 14, 14));
+  EXPECT_EQ(bank.PositionVelocityCovariance(1), math::Vector3d(6, 6, 6));
+
+  EXPECT_TRUE(bank.RemoveTrack(0));
+  EXPECT_FALSE(bank.RemoveTrack(2));
+  EXPECT_EQ(bank.Count(), 2u);
+  EXPECT_EQ(bank.Position(0), math::Vector3d(7, 8, 9));
+  EXPECT_EQ(bank.Position(1), math::Vector3d(6, 5, 6));
+
+  EXPECT_FALSE(bank.Update({math::Vector3d::Zero}));
+  EXPECT_FALSE(bank.Update({0, 1}, {math::Vector3d::Zero}));
+  EXPECT_FALSE(bank.Update({5}, {math::Vector3d::Zero}));
+  EXPECT_EQ(bank.Position(0), math::Vector3d(7, 8, 9));
+
+  bank.Clear();
+  EXPECT_EQ(bank.Count(), 0u);
+
+  // Exact measurements of an exact position are ignored
+  bank.SetMeasurementNoise(0.0);
+  bank.AddTrack(math::Vector3d(1, 2, 3), math::Vector3d::Zero, 0.0, 0.0);
+  EXPECT_TRUE(bank.Update({math::Vector3d(1, 2, 4)}));
+  EXPECT_EQ(bank.Position(0), math::Vector3d(1, 2, 3));
+  EXPECT_EQ(bank.Velocity(0), math::Vector3d::Zero);
+
+  // Exact measurements of an uncertain position replace it
+  bank.SetProcessNoise(1.0);
+  bank.Predict(1.0);
+  EXPECT_TRUE(bank.Update({math::Vector3d(1, 2, 4)}));
+  EXPECT_EQ(bank.Position(0), math::Vector3d(1, 2, 4));
+  EXPECT_EQ(bank.PositionVariance(0), math::Vector3d::Zero);
+}
+
+/////////////////////////////////////////////////
+TEST(ConstantVelocityTrackerBankTest, MatchesKalmanFilter)
+{
+  const double q = 0.3;
+  const double r = 0.2;
+  const double dt = 0.1;
+  math::ConstantVelocityTrackerBank bank(q, r);
+  bank.AddTrack(math::Vector3d(0, 0, 0), math::Vector3d(0, 0, 0), 4.0, 9.0);
+
+  // Reference Kalman filter of one axis with full 2x2 matrices
+  double x[2] = {0.0, 0.0};
+  double p[2][2] = {{4.0, 0.0}, {0.0, 9.0}};
+  const double f[2][2] = {{1.0, dt}, {0.0, 1.0}};
+  const double qm[2][2] = {{q * dt * dt * dt / 3, q * dt * dt / 2},
+                           {q * dt * dt / 2, q * dt}};
+
+  for (int step = 0; step < 50; ++step)
+  {
+    bank.Predict(dt);
+    const double xp[2] = {x[0] + dt * x[1], x[1]};
+    double fp[2][2];
+    for (int i = 0; i < 2; ++i)
+      for (int j = 0; j < 2; ++j)
+        fp[i][j] = f[i][0] * p[0][j] + f[i][1] * p[1][j];
+    for (int i = 0; i < 2; ++i)
+      for (int j = 0; j < 2; ++j)
+        p[i][j] = fp[i][0] * f[j][0] + fp[i][1] * f[j][1] + qm[i][j];
+    x[0] = xp[0];
+    x[1] = xp[1];
+
+    const double z = 0.5 * step * dt + math::Rand::DblNormal(0, 0.3);
+    EXPECT_TRUE(bank.Update({math::Vector3d(z, 2 * z, -z)}));
+    const double s = p[0][0] + r;
+    const double k[2] = {p[0][0] / s, p[1][0] / s};
+    const double residual = z - x[0];
+    x[0] += k[0] * residual;
+    x[1] += k[1] * residual;
+    double updated[2][2];
+    for (int i = 0; i < 2; ++i)
+      for (int j = 0; j < 2; ++j)
+        updated[i][j] = p[i][j] - k[i] * p[0][j];
+    for (int i = 0; i < 2; ++i)
+      for (int j = 0; j < 2; ++j)
+        p[i][j] = updated[i][j];
+
+    EXPECT_NEAR(bank.Position(0).X(), x[0], 1e-9);
+    EXPECT_NEAR(bank.Position(0).Y(), 2 * x[0], 1e-9);
+    EXPECT_NEAR(bank.Position(0).Z(), -x[0], 1e-9);
+    EXPECT_NEAR(bank.Velocity(0).X(), x[1], 1e-9);
+    EXPECT_NEAR(bank.PositionVariance(0).X(), p[0][0], 1e-12);
+    EXPECT_NEAR(bank.PositionVelocityCovariance(0).X(), p[0][1], 1e-12);
+    EXPECT_NEAR(bank.VelocityVariance(0).X(), p[1][1], 1e-12);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ConstantVelocityTrackerBankTest, ManyTracks)
+{
+  const size_t count = 1000;
+  const double dt = 0.05;
+  math::ConstantVelocityTrackerBank bank(0.01, 0.01);
+
+  std::vector<math::Vector3d> positions(count);
+  std::vector<math::Vector3d> velocities(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    positions[i].Set(math::Rand::DblUniform(-10, 10),
+        math::Rand::DblUniform(-10, 10), math::Rand::DblUniform(-10, 10));
+    velocities[i].Set(math::Rand::DblUniform(-1, 1),
+        math::Rand::DblUniform(-1, 1), math::Rand::DblUniform(-1, 1));
+    bank.AddTrack(positions[i]);
+  }
+
+  std::vector<size_t> evenIndices;
+  for (size_t i = 0; i < count; i += 2)
+    evenIndices.push_back(i);
+
+  std::vector<math::Vector3d> measured(count);
+  for (int step = 0; step < 200; ++step)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      positions[i] += velocities[i] * dt;
+      measured[i] = positions[i] + math::Vector3d(
+          math::Rand::DblNormal(0, 0.1), math::Rand::DblNormal(0, 0.1),
+          math::Rand::DblNormal(0, 0.1));
+    }
+
+    bank.Predict(dt);
+    if (step % 2 == 0)
+    {
+      EXPECT_TRUE(bank.Update(measured));
+    }
+    else
+    {
+      // Only even tracks are measured on odd steps
+      std::vector<math::Vector3d> even;
+      for (size_t i : evenIndices)
+        even.push_back(measured[i]);
+      EXPECT_TRUE(bank.Update(evenIndices, even));
+    }
+  }
+
+  for (size_t i = 0; i < count; ++i)
+  {
+    EXPECT_LT((bank.Velocity(i) - velocities[i]).Length(), 0.3) << i;
+    EXPECT_LT((bank.Position(i) - positions[i]).Length(), 0.3) << i;
+  }
+
+  // Even tracks got more measurements, so they are more certain
+  EXPECT_LT(bank.PositionVariance(0).X(), bank.PositionVariance(1).X());
+}
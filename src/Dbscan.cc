@@ -0,0 +1,499 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <thread>
+#include <utility>
+
+#include "ignition/math/Dbscan.hh"
+#include "ChunkPool.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+/// \brief Index of no point.
+const size_t kNone = std::numeric_limits<size_t>::max();
+
+/// \brief Number of grid cells processed by each chunk of work.
+const size_t kCellsPerChunk = 256;
+
+//////////////////////////////////////////////////
+/// \brief Points sorted by grid cell, with the cells as ranges of the
+/// sorted points.
+class Grid
+{
+  /// \brief Build the grid of the finite points.
+  /// \param[in] _points Points.
+  /// \param[in] _count Number of points.
+  /// \param[in] _size Size of the cells.
+  /// \return False if the grid would have too many cells.
+  public: bool Build(const Vector3d *_points, size_t _count, double _size)
+  {
+    Vector3d min(HUGE_VAL, HUGE_VAL, HUGE_VAL);
+    Vector3d max(-HUGE_VAL, -HUGE_VAL, -HUGE_VAL);
+    for (size_t i = 0; i < _count; ++i)
+    {
+      if (_points[i].IsFinite())
+      {
+        min.Min(_points[i]);
+        max.Max(_points[i]);
+      }
+    }
+
+    // Number of cells along each axis, checked in double precision so
+    // that keys cannot overflow.
+    double total = 1;
+    for (int a = 0; a < 3; ++a)
+    {
+      const double cells = min[a] <= max[a] ?
+        std::floor((max[a] - min[a]) / _size) + 1 : 1;
+      total *= cells;
+      if (total > 4611686018427387904.0)
+      {
+        std::cerr << "Dbscan error: epsilon [" << _size << "] is too small"
+                  << " for the extent of the points" << std::endl;
+        return false;
+      }
+      this->dims[a] = static_cast<uint64_t>(cells);
+    }
+
+    std::vector<std::pair<uint64_t, size_t>> entries;
+    entries.reserve(_count);
+    for (size_t i = 0; i < _count; ++i)
+    {
+      const Vector3d &p = _points[i];
+      if (!p.IsFinite())
+        continue;
+
+      uint64_t cell[3];
+      for (int a = 0; a < 3; ++a)
+      {
+        cell[a] = std::min(this->dims[a] - 1,
+            static_cast<uint64_t>((p[a] - min[a]) / _size));
+      }
+      entries.emplace_back(this->Key(cell[0], cell[1], cell[2]), i);
+    }
+    std::sort(entries.begin(), entries.end());
+
+    this->points.resize(entries.size());
+    this->index.resize(entries.size());
+    this->keys.clear();
+    this->start.clear();
+    for (size_t s = 0; s < entries.size(); ++s)
+    {
+      if (s == 0 || entries[s].first != entries[s - 1].first)
+      {
+        this->keys.push_back(entries[s].first);
+        this->start.push_back(s);
+      }
+      this->points[s] = _points[entries[s].second];
+      this->index[s] = entries[s].second;
+    }
+    this->start.push_back(entries.size());
+    return true;
+  }
+
+  /// \brief Get the cells next to a cell, including itself, in increasing
+  /// order.
+  ///
+  /// Cells with the same x and y are consecutive along z, so each of the
+  /// 9 columns around the cell is a single range of keys. For cells
+  /// visited in increasing order, the start of each column only moves
+  /// forward, so it is searched from its previous position.
+  /// \param[in] _cell Cell index.
+  /// \param[in,out] _cursors Start of each column for the previous cell,
+  /// zero before the first cell.
+  /// \param[out] _neighbors Neighbor cell indices.
+  public: void Neighbors(size_t _cell, size_t _cursors[9],
+              std::vector<size_t> &_neighbors) const
+  {
+    const uint64_t key = this->keys[_cell];
+    const uint64_t z = key % this->dims[2];
+    const uint64_t y = (key / this->dims[2]) % this->dims[1];
+    const uint64_t x = key / (this->dims[2] * this->dims[1]);
+    const uint64_t zMin = z > 0 ? z - 1 : 0;
+    const uint64_t zMax = std::min(z + 1, this->dims[2] - 1);
+
+    _neighbors.clear();
+    for (uint64_t nx = x > 0 ? x - 1 : 0;
+         nx <= std::min(x + 1, this->dims[0] - 1); ++nx)
+    {
+      for (uint64_t ny = y > 0 ? y - 1 : 0;
+           ny <= std::min(y + 1, this->dims[1] - 1); ++ny)
+      {
+        size_t &cursor = _cursors[(nx + 1 - x) * 3 + (ny + 1 - y)];
+        cursor = this->Seek(cursor, this->Key(nx, ny, zMin));
+        const uint64_t last = this->Key(nx, ny, zMax);
+        for (size_t n = cursor; n < this->keys.size() && this->keys[n] <= last;
+             ++n)
+        {
+          _neighbors.push_back(n);
+        }
+      }
+    }
+  }
+
+  /// \brief Find the first cell with a key not less than a key, with an
+  /// exponential search from a cell.
+  /// \param[in] _from First cell to consider. All cells before it have
+  /// smaller keys.
+  /// \param[in] _key Key.
+  /// \return Cell index, or the number of cells if there is none.
+  private: size_t Seek(size_t _from, uint64_t _key) const
+  {
+    size_t lo = _from;
+    size_t hi = _from;
+    size_t step = 1;
+    while (hi < this->keys.size() && this->keys[hi] < _key)
+    {
+      lo = hi + 1;
+      hi += step;
+      step *= 2;
+    }
+    hi = std::min(hi, this->keys.size());
+    return static_cast<size_t>(std::lower_bound(this->keys.begin() + lo,
+          this->keys.begin() + hi, _key) - this->keys.begin());
+  }
+
+  /// \brief Get the key of a cell.
+  /// \param[in] _x X index.
+  /// \param[in] _y Y index.
+  /// \param[in] _z Z index.
+  /// \return Key, increasing with z, then y, then x.
+  private: uint64_t Key(uint64_t _x, uint64_t _y, uint64_t _z) const
+  {
+    return (_x * this->dims[1] + _y) * this->dims[2] + _z;
+  }
+
+  /// \brief Finite points, sorted by cell.
+  public: std::vector<Vector3d> points;
+
+  /// \brief Index of each sorted point in the input.
+  public: std::vector<size_t> index;
+
+  /// \brief Key of each occupied cell, increasing.
+  public: std::vector<uint64_t> keys;
+
+  /// \brief First sorted point of each cell, followed by the number of
+  /// sorted points.
+  public: std::vector<size_t> start;
+
+  /// \brief Number of cells along each axis.
+  private: uint64_t dims[3] = {1, 1, 1};
+};
+
+//////////////////////////////////////////////////
+/// \brief Union-find that can be updated from several threads. The root
+/// of a set is its smallest element.
+class UnionFind
+{
+  /// \brief Constructor.
+  /// \param[in] _count Number of elements, each in its own set.
+  public: explicit UnionFind(size_t _count)
+    : parent(_count)
+  {
+    for (size_t i = 0; i < _count; ++i)
+      this->parent[i].store(i, std::memory_order_relaxed);
+  }
+
+  /// \brief Find the root of the set of an element, halving the path to
+  /// it.
+  /// \param[in] _x Element.
+  /// \return Root.
+  public: size_t Find(size_t _x)
+  {
+    while (true)
+    {
+      size_t p = this->parent[_x].load();
+      if (p == _x)
+        return _x;
+
+      const size_t g = this->parent[p].load();
+      if (g != p)
+        this->parent[_x].compare_exchange_weak(p, g);
+      _x = g;
+    }
+  }
+
+  /// \brief Merge the sets of two elements. The larger root is linked to
+  /// the smaller one, so the result does not depend on the order of the
+  /// merges.
+  /// \param[in] _a First element.
+  /// \param[in] _b Second element.
+  public: void Unite(size_t _a, size_t _b)
+  {
+    while (true)
+    {
+      _a = this->Find(_a);
+      _b = this->Find(_b);
+      if (_a == _b)
+        return;
+      if (_a < _b)
+        std::swap(_a, _b);
+
+      size_t expected = _a;
+      if (this->parent[_a].compare_exchange_strong(expected, _b))
+        return;
+    }
+  }
+
+  /// \brief Parent of each element.
+  private: std::vector<std::atomic<size_t>> parent;
+};
+}
+
+/// \brief Private data for the Dbscan class.
+class ignition::math::DbscanPrivate
+{
+  /// \brief Radius of the neighborhood of a point.
+  public: double epsilon = 0;
+
+  /// \brief Number of points in the neighborhood of a core point.
+  public: unsigned int minPoints = 1;
+
+  /// \brief Number of threads used by Cluster.
+  public: unsigned int threads = 1;
+
+  /// \brief Number of clusters found by the last call to Cluster.
+  public: unsigned int clusters = 0;
+};
+
+//////////////////////////////////////////////////
+Dbscan::Dbscan(double _epsilon, unsigned int _minPoints)
+  : dataPtr(new DbscanPrivate)
+{
+  this->Epsilon(_epsilon);
+  this->MinPoints(_minPoints);
+}
+
+//////////////////////////////////////////////////
+Dbscan::~Dbscan()
+{
+}
+
+//////////////////////////////////////////////////
+double Dbscan::Epsilon() const
+{
+  return this->dataPtr->epsilon;
+}
+
+//////////////////////////////////////////////////
+void Dbscan::Epsilon(double _epsilon)
+{
+  this->dataPtr->epsilon = _epsilon;
+}
+
+//////////////////////////////////////////////////
+unsigned int Dbscan::MinPoints() const
+{
+  return this->dataPtr->minPoints;
+}
+
+//////////////////////////////////////////////////
+void Dbscan::MinPoints(unsigned int _minPoints)
+{
+  this->dataPtr->minPoints = std::max(_minPoints, 1u);
+}
+
+//////////////////////////////////////////////////
+void Dbscan::Threads(unsigned int _threads)
+{
+  if (_threads == 0)
+    _threads = std::max(1u, std::thread::hardware_concurrency());
+  this->dataPtr->threads = _threads;
+}
+
+//////////////////////////////////////////////////
+unsigned int Dbscan::Threads() const
+{
+  return this->dataPtr->threads;
+}
+
+//////////////////////////////////////////////////
+unsigned int Dbscan::ClusterCount() const
+{
+  return this->dataPtr->clusters;
+}
+
+//////////////////////////////////////////////////
+bool Dbscan::Cluster(const std::vector<Vector3d> &_points,
+    std::vector<int> &_labels)
+{
+  _labels.resize(_points.size());
+  return this->Cluster(_points.data(), _points.size(), _labels.data());
+}
+
+//////////////////////////////////////////////////
+bool Dbscan::Cluster(const Vector3d *_points, size_t _count, int *_labels)
+{
+  this->dataPtr->clusters = 0;
+  if (_count > 0 && (!_points || !_labels))
+  {
+    std::cerr << "Dbscan error: null points or labels" << std::endl;
+    return false;
+  }
+
+  const double epsilon = this->dataPtr->epsilon;
+  if (!(epsilon > 0) || !std::isfinite(epsilon))
+  {
+    std::cerr << "Dbscan error: epsilon has to be positive and finite but"
+              << " its value is [" << epsilon << "]" << std::endl;
+    return false;
+  }
+
+  Grid grid;
+  if (!grid.Build(_points, _count, epsilon))
+    return false;
+
+  const double epsilon2 = epsilon * epsilon;
+  const size_t minPoints = this->dataPtr->minPoints;
+  const size_t cells = grid.keys.size();
+  const size_t chunks = (cells + kCellsPerChunk - 1) / kCellsPerChunk;
+  ChunkPool pool(static_cast<unsigned int>(
+        std::min<size_t>(this->dataPtr->threads, std::max<size_t>(chunks, 1))));
+
+  // Run a function on each cell with its neighbor cells.
+  auto forEachCell = [&](const std::function<void(size_t,
+        const std::vector<size_t> &)> &_function)
+  {
+    pool.Run(chunks, [&](size_t _c)
+    {
+      std::vector<size_t> neighbors;
+      size_t cursors[9] = {0};
+      const size_t end = std::min(cells, (_c + 1) * kCellsPerChunk);
+      for (size_t cell = _c * kCellsPerChunk; cell < end; ++cell)
+      {
+        grid.Neighbors(cell, cursors, neighbors);
+        _function(cell, neighbors);
+      }
+    });
+  };
+
+  // Find the core points, stopping each count at minPoints.
+  const std::vector<Vector3d> &points = grid.points;
+  std::vector<uint8_t> core(points.size(), minPoints <= 1);
+  if (minPoints > 1)
+  {
+    forEachCell([&](size_t _cell, const std::vector<size_t> &_neighbors)
+    {
+      for (size_t s = grid.start[_cell]; s < grid.start[_cell + 1]; ++s)
+      {
+        size_t count = 0;
+        for (size_t n = 0; n < _neighbors.size() && count < minPoints; ++n)
+        {
+          const size_t end = grid.start[_neighbors[n] + 1];
+          for (size_t t = grid.start[_neighbors[n]];
+               t < end && count < minPoints; ++t)
+          {
+            if ((points[s] - points[t]).SquaredLength() <= epsilon2)
+              ++count;
+          }
+        }
+        core[s] = count >= minPoints;
+      }
+    });
+  }
+
+  // Merge the core points that are neighbors. Each pair is visited once,
+  // from the point with the smaller sorted index.
+  UnionFind sets(points.size());
+  forEachCell([&](size_t _cell, const std::vector<size_t> &_neighbors)
+  {
+    for (size_t s = grid.start[_cell]; s < grid.start[_cell + 1]; ++s)
+    {
+      if (!core[s])
+        continue;
+      for (size_t n : _neighbors)
+      {
+        if (n < _cell)
+          continue;
+        for (size_t t = std::max(s + 1, grid.start[n]);
+             t < grid.start[n + 1]; ++t)
+        {
+          if (core[t] &&
+              (points[s] - points[t]).SquaredLength() <= epsilon2)
+          {
+            sets.Unite(s, t);
+          }
+        }
+      }
+    }
+  });
+
+  // Attach the other points to their closest core point, breaking ties
+  // with the input order.
+  std::vector<size_t> attach(points.size(), kNone);
+  forEachCell([&](size_t _cell, const std::vector<size_t> &_neighbors)
+  {
+    for (size_t s = grid.start[_cell]; s < grid.start[_cell + 1]; ++s)
+    {
+      if (core[s])
+        continue;
+      double best = epsilon2;
+      for (size_t n : _neighbors)
+      {
+        for (size_t t = grid.start[n]; t < grid.start[n + 1]; ++t)
+        {
+          if (!core[t])
+            continue;
+          const double d = (points[s] - points[t]).SquaredLength();
+          if (d < best || (!(d > best) && (attach[s] == kNone ||
+              grid.index[t] < grid.index[attach[s]])))
+          {
+            best = d;
+            attach[s] = t;
+          }
+        }
+      }
+    }
+  });
+
+  // Number the clusters in the order of their first core point.
+  std::fill(_labels, _labels + _count, Noise);
+  std::vector<size_t> sorted(_count, kNone);
+  for (size_t s = 0; s < points.size(); ++s)
+    sorted[grid.index[s]] = s;
+
+  std::vector<int> rootLabel(points.size(), Noise);
+  int next = 0;
+  for (size_t i = 0; i < _count; ++i)
+  {
+    const size_t s = sorted[i];
+    if (s == kNone || !core[s])
+      continue;
+    const size_t root = sets.Find(s);
+    if (rootLabel[root] == Noise)
+      rootLabel[root] = next++;
+    _labels[i] = rootLabel[root];
+  }
+
+  for (size_t s = 0; s < points.size(); ++s)
+  {
+    if (!core[s] && attach[s] != kNone)
+      _labels[grid.index[s]] = rootLabel[sets.Find(attach[s])];
+  }
+
+  this->dataPtr->clusters = static_cast<unsigned int>(next);
+  return true;
+}
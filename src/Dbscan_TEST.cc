@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "ignition/math/Dbscan.hh"
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/RandomGenerator.hh"
+
+using namespace ignition;
+
+/// \brief Cluster points by checking every pair of points.
+/// \param[in] _points Points.
+/// \param[in] _epsilon Radius of the neighborhood of a point.
+/// \param[in] _minPoints Number of points in the neighborhood of a core
+/// point.
+/// \return Labels, numbered like Dbscan.
+std::vector<int> BruteForce(const std::vector<math::Vector3d> &_points,
+    double _epsilon, size_t _minPoints)
+{
+  const size_t count = _points.size();
+  const double epsilon2 = _epsilon * _epsilon;
+  auto near = [&](size_t _i, size_t _j)
+  {
+    return (_points[_i] - _points[_j]).SquaredLength() <= epsilon2;
+  };
+
+  std::vector<bool> core(count);
+  for (size_t i = 0; i < count; ++i)
+  {
+    size_t neighbors = 0;
+    for (size_t j = 0; j < count; ++j)
+      neighbors += near(i, j);
+    core[i] = neighbors >= _minPoints;
+  }
+
+  // Flood the core points from the first one of each cluster.
+  std::vector<int> labels(count, math::Dbscan::Noise);
+  int next = 0;
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!core[i] || labels[i] != math::Dbscan::Noise)
+      continue;
+    std::vector<size_t> stack = {i};
+    labels[i] = next;
+    while (!stack.empty())
+    {
+      const size_t p = stack.back();
+      stack.pop_back();
+      for (size_t j = 0; j < count; ++j)
+      {
+        if (core[j] && labels[j] == math::Dbscan::Noise && near(p, j))
+        {
+          labels[j] = next;
+          stack.push_back(j);
+        }
+      }
+    }
+    ++next;
+  }
+
+  // Other points join their closest core point.
+  std::vector<int> result = labels;
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (core[i])
+      continue;
+    double best = std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < count; ++j)
+    {
+      const double d = (_points[i] - _points[j]).SquaredLength();
+      if (core[j] && d <= epsilon2 && d < best)
+      {
+        best = d;
+        result[i] = labels[j];
+      }
+    }
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+TEST(DbscanTest, Parameters)
+{
+  math::Dbscan dbscan(0.5, 0);
+  EXPECT_DOUBLE_EQ(dbscan.Epsilon(), 0.5);
+  EXPECT_EQ(dbscan.MinPoints(), 1u);
+  EXPECT_EQ(dbscan.Threads(), 1u);
+  EXPECT_EQ(dbscan.ClusterCount(), 0u);
+
+  dbscan.Epsilon(2.0);
+  dbscan.MinPoints(4);
+  dbscan.Threads(0);
+  EXPECT_DOUBLE_EQ(dbscan.Epsilon(), 2.0);
+  EXPECT_EQ(dbscan.MinPoints(), 4u);
+  EXPECT_GE(dbscan.Threads(), 1u);
+
+  // Invalid input
+  std::vector<int> labels;
+  const std::vector<math::Vector3d> points = {math::Vector3d::Zero};
+  EXPECT_FALSE(dbscan.Cluster(nullptr, 1, labels.data()));
+  for (double epsilon : {0.0, -1.0, std::nan(""), math::INF_D})
+  {
+    dbscan.Epsilon(epsilon);
+    EXPECT_FALSE(dbscan.Cluster(points, labels));
+  }
+
+  // Too many cells
+  dbscan.Epsilon(1e-12);
+  EXPECT_FALSE(dbscan.Cluster({math::Vector3d::Zero,
+      math::Vector3d(1e3, 1e3, 1e3)}, labels));
+
+  // No points
+  dbscan.Epsilon(1.0);
+  EXPECT_TRUE(dbscan.Cluster({}, labels));
+  EXPECT_TRUE(labels.empty());
+  EXPECT_EQ(dbscan.ClusterCount(), 0u);
+}
+
+//////////////////////////////////////////////////
+TEST(DbscanTest, Shapes)
+{
+  // A ring around a ball, a line, isolated noise and a non finite point.
+  std::vector<math::Vector3d> points;
+  for (int i = 0; i < 200; ++i)
+  {
+    const double angle = 2 * IGN_PI * i / 200;
+    points.emplace_back(10 * std::cos(angle), 10 * std::sin(angle), 0);
+  }
+  math::RandomGenerator generator(3);
+  for (int i = 0; i < 200; ++i)
+  {
+    points.emplace_back(generator.DblNormal(0, 0.5),
+        generator.DblNormal(0, 0.5), generator.DblNormal(0, 0.5));
+  }
+  for (int i = 0; i < 50; ++i)
+    points.emplace_back(30, 0, i * 0.2);
+  points.emplace_back(-30, 0, 0);
+  points.emplace_back(0, 30, 20);
+  points.emplace_back(std::nan(""), 0, 0);
+
+  math::Dbscan dbscan(0.6, 3);
+  std::vector<int> labels;
+  ASSERT_TRUE(dbscan.Cluster(points, labels));
+  ASSERT_EQ(labels.size(), points.size());
+  EXPECT_EQ(dbscan.ClusterCount(), 3u);
+
+  // Clusters are numbered in the order of their first core point
+  for (int i = 0; i < 200; ++i)
+    EXPECT_EQ(labels[i], 0);
+  EXPECT_EQ(labels[300], 1);
+  for (int i = 400; i < 450; ++i)
+    EXPECT_EQ(labels[i], 2);
+  EXPECT_EQ(labels[450], math::Dbscan::Noise);
+  EXPECT_EQ(labels[451], math::Dbscan::Noise);
+  EXPECT_EQ(labels[452], math::Dbscan::Noise);
+
+  // A single point per cluster is enough with minPoints of one
+  dbscan.MinPoints(1);
+  ASSERT_TRUE(dbscan.Cluster(points, labels));
+  EXPECT_GE(dbscan.ClusterCount(), 5u);
+  EXPECT_NE(labels[450], math::Dbscan::Noise);
+  EXPECT_NE(labels[451], math::Dbscan::Noise);
+  EXPECT_NE(labels[450], labels[451]);
+  EXPECT_EQ(labels[452], math::Dbscan::Noise);
+}
+
+//////////////////////////////////////////////////
+TEST(DbscanTest, BruteForce)
+{
+  math::RandomGenerator generator(5);
+  std::vector<math::Vector3d> points(1500);
+  for (auto &p : points)
+  {
+    p.Set(generator.DblUniform(0, 10), generator.DblUniform(0, 10),
+        generator.DblUniform(0, 2));
+  }
+  // Points exactly epsilon apart are neighbors
+  points.push_back(math::Vector3d(20, 20, 20));
+  points.push_back(math::Vector3d(20.5, 20, 20));
+
+  for (double epsilon : {0.3, 0.5, 0.8})
+  {
+    for (unsigned int minPoints : {2u, 5u, 8u})
+    {
+      math::Dbscan dbscan(epsilon, minPoints);
+      std::vector<int> labels;
+      ASSERT_TRUE(dbscan.Cluster(points, labels));
+      const std::vector<int> expected =
+        BruteForce(points, epsilon, minPoints);
+      EXPECT_EQ(labels, expected) << epsilon << " " << minPoints;
+
+      int clusters = 0;
+      for (int label : expected)
+        clusters = std::max(clusters, label + 1);
+      EXPECT_EQ(dbscan.ClusterCount(), static_cast<unsigned int>(clusters));
+
+      // Results do not depend on the number of threads
+      for (unsigned int threads : {2u, 7u})
+      {
+        dbscan.Threads(threads);
+        std::vector<int> threaded(points.size());
+        ASSERT_TRUE(dbscan.Cluster(points.data(), points.size(),
+            threaded.data()));
+        EXPECT_EQ(threaded, labels);
+      }
+    }
+  }
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/Filter.hh"
+#include "ignition/math/FilterBank.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(FilterBankTest, OnePoleBank)
+{
+  const size_t channels = 7;
+  math::OnePoleBank<double> bank(channels, 0.1, 1.0);
+  EXPECT_EQ(bank.Channels(), channels);
+  bank.ChannelFc(3, 0.3, 1.0);
+
+  std::vector<math::OnePole<double>> filters(channels,
+      math::OnePole<double>(0.1, 1.0));
+  filters[3].Fc(0.3, 1.0);
+
+  bank.Set(1.5);
+  bank.Set(2, -1.0);
+  for (auto &filter : filters)
+    filter.Set(1.5);
+  filters[2].Set(-1.0);
+
+  std::vector<double> frame(channels);
+  for (int n = 0; n < 50; ++n)
+  {
+    for (auto &x : frame)
+      x = math::Rand::DblUniform(-1.0, 1.0);
+    const std::vector<double> &y = bank.Process(frame);
+    for (size_t i = 0; i < channels; ++i)
+      EXPECT_NEAR(y[i], filters[i].Process(frame[i]), 1e-12);
+  }
+  EXPECT_EQ(&bank.Value(), &bank.Process(frame));
+}
+
+/////////////////////////////////////////////////
+TEST(FilterBankTest, BiQuadBank)
+{
+  const size_t channels = 5;
+  math::BiQuadBank<double> bank(channels, 0.1, 1.0);
+  EXPECT_EQ(bank.Channels(), channels);
+  bank.ChannelFc(1, 0.2, 1.0, 0.8);
+  bank.ChannelFc(3, 0.3, 1.0);
+
+  std::vector<math::BiQuad<double>> filters(channels,
+      math::BiQuad<double>(0.1, 1.0));
+  filters[1].Fc(0.2, 1.0, 0.8);
+  filters[3].Fc(0.3, 1.0);
+
+  bank.Set(2.0);
+  bank.Set(4, 0.5);
+  for (auto &filter : filters)
+    filter.Set(2.0);
+  filters[4].Set(0.5);
+
+  std::vector<double> frame(channels);
+  for (int n = 0; n < 100; ++n)
+  {
+    for (auto &x : frame)
+      x = math::Rand::DblUniform(-1.0, 1.0);
+    const std::vector<double> &y = bank.Process(frame);
+    for (size_t i = 0; i < channels; ++i)
+      EXPECT_NEAR(y[i], filters[i].Process(frame[i]), 1e-12);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(FilterBankTest, BiQuadBankFloat)
+{
+  math::BiQuadBank<float> bank(3, 0.05, 1.0);
+  bank.Set(1.0f);
+  std::vector<float> frame(3, 1.0f);
+  for (int n = 0; n < 10; ++n)
+  {
+    for (float y : bank.Process(frame))
+      EXPECT_NEAR(y, 1.0f, 1e-5f);
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(FilterBankTest, Butterworth)
+{
+  const size_t channels = 4;
+
+  // A second order Butterworth filter is a BiQuad with Q = 1/sqrt(2)
+  math::BiQuadCascadeBank<double> second(channels);
+  second.Butterworth(2, 0.1, 1.0);
+  ASSERT_EQ(second.Sections().size(), 1u);
+  math::BiQuad<double> filter;
+  filter.Fc(0.1, 1.0, 1.0 / std::sqrt(2.0));
+
+  std::vector<double> frame(channels);
+  for (int n = 0; n < 50; ++n)
+  {
+    const double x = math::Rand::DblUniform(-1.0, 1.0);
+    frame.assign(channels, x);
+    const double expected = filter.Process(x);
+    for (double y : second.Process(frame))
+      EXPECT_NEAR(y, expected, 1e-12);
+  }
+
+  // Higher orders have unity gain at DC and attenuate faster above the
+  // cutoff frequency.
+  for (unsigned int order : {3u, 4u, 5u})
+  {
+    math::BiQuadCascadeBank<double> bank(channels);
+    bank.Butterworth(order, 0.05, 1.0);
+    EXPECT_EQ(bank.Sections().size(), (order + 1) / 2);
+    EXPECT_EQ(bank.Channels(), channels);
+
+    // Step response settles to the input
+    frame.assign(channels, 1.0);
+    for (int n = 0; n < 1000; ++n)
+      bank.Process(frame);
+    for (double y : bank.Value())
+      EXPECT_NEAR(y, 1.0, 1e-9) << order;
+
+    // Set starts in steady state
+    bank.Set(-2.0);
+    frame.assign(channels, -2.0);
+    for (double y : bank.Process(frame))
+      EXPECT_NEAR(y, -2.0, 1e-9) << order;
+
+    // Amplitude at a quarter of the sample rate, well above the cutoff
+    bank.Set(0.0);
+    double peak = 0.0;
+    for (int n = 0; n < 2000; ++n)
+    {
+      const double x = std::sin(IGN_PI * 0.5 * n);
+      frame.assign(channels, x);
+      const double y = bank.Process(frame)[0];
+      if (n > 1000)
+        peak = std::max(peak, std::abs(y));
+    }
+    // The Butterworth gain at f is 1/sqrt(1 + (f/fc)^(2n)) before warping
+    EXPECT_LT(peak, 1.0 / std::pow(0.25 / 0.05, order)) << order;
+  }
+
+  // A cascade without sections passes the input through
+  math::BiQuadCascadeBank<double> empty(2);
+  EXPECT_DOUBLE_EQ(empty.Process({1.0, 2.0})[1], 2.0);
+}
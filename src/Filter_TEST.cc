@@ -17,6 +17,9 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <vector>
+
 #include "ignition/math/Filter.hh"
 
 using namespace ignition;
@@ -103,3 +106,95 @@ TEST(FilterTest, BiquadVector3)
   EXPECT_EQ(filterB.Process(math::Vector3d(0.1, 20.3, 33.45)),
             math::Vector3d(0.031748, 6.44475, 10.6196));
 }
+
+/////////////////////////////////////////////////
+TEST(FilterTest, OnePoleBlock)
+{
+  math::OnePole<double> single(0.1, 1.0);
+  math::OnePole<double> block(0.1, 1.0);
+  single.Set(0.5);
+  block.Set(0.5);
+
+  std::vector<double> in(64);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = std::sin(0.3 * i);
+
+  std::vector<double> out;
+  block.Process(in, out);
+  ASSERT_EQ(out.size(), in.size());
+  for (size_t i = 0; i < in.size(); ++i)
+    EXPECT_DOUBLE_EQ(out[i], single.Process(in[i]));
+  EXPECT_DOUBLE_EQ(block.Value(), single.Value());
+
+  // In place
+  block.Process(in, in);
+  EXPECT_DOUBLE_EQ(in.back(), block.Value());
+
+  math::OnePoleVector3 vecSingle(0.2, 1.0);
+  math::OnePoleVector3 vecBlock(0.2, 1.0);
+  std::vector<math::Vector3d> vecIn(10, math::Vector3d(1, 2, 3));
+  std::vector<math::Vector3d> vecOut;
+  vecBlock.Process(vecIn, vecOut);
+  for (size_t i = 0; i < vecIn.size(); ++i)
+    EXPECT_EQ(vecOut[i], vecSingle.Process(vecIn[i]));
+}
+
+/////////////////////////////////////////////////
+TEST(FilterTest, OnePoleQuaternionBlock)
+{
+  math::OnePoleQuaternion single(0.1, 1.0);
+  math::OnePoleQuaternion block(0.1, 1.0);
+
+  std::vector<math::Quaterniond> in;
+  for (int i = 0; i < 20; ++i)
+    in.push_back(math::Quaterniond(0.1 * i, 0.2, -0.05 * i));
+
+  std::vector<math::Quaterniond> out;
+  block.Process(in, out);
+  ASSERT_EQ(out.size(), in.size());
+  for (size_t i = 0; i < in.size(); ++i)
+    EXPECT_EQ(out[i], single.Process(in[i]));
+  EXPECT_EQ(block.Value(), single.Value());
+}
+
+/////////////////////////////////////////////////
+TEST(FilterTest, BiQuadBlock)
+{
+  math::BiQuad<double> single;
+  math::BiQuad<double> block;
+  single.Fc(0.1, 1.0, 0.7);
+  block.Fc(0.1, 1.0, 0.7);
+  single.Set(1.0);
+  block.Set(1.0);
+
+  std::vector<double> in(100);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = std::cos(0.2 * i) + 0.5 * std::sin(1.3 * i);
+
+  // Alternate blocks of several sizes with single samples, to verify the
+  // state carries over in both directions.
+  std::vector<double> out;
+  size_t i = 0;
+  for (size_t size : {0u, 1u, 2u, 7u, 1u, 30u})
+  {
+    std::vector<double> chunk(in.begin() + i, in.begin() + i + size);
+    block.Process(chunk, out);
+    ASSERT_EQ(out.size(), size);
+    for (size_t j = 0; j < size; ++j)
+      EXPECT_NEAR(out[j], single.Process(in[i + j]), 1e-12);
+    i += size;
+
+    EXPECT_NEAR(block.Process(in[i]), single.Process(in[i]), 1e-12);
+    ++i;
+  }
+
+  math::BiQuadVector3 vecSingle(0.2, 1.0);
+  math::BiQuadVector3 vecBlock(0.2, 1.0);
+  std::vector<math::Vector3d> vecIn;
+  for (int k = 0; k < 10; ++k)
+    vecIn.push_back(math::Vector3d(k, -k, 0.5 * k));
+  std::vector<math::Vector3d> vecOut;
+  vecBlock.Process(vecIn, vecOut);
+  for (size_t k = 0; k < vecIn.size(); ++k)
+    EXPECT_EQ(vecOut[k], vecSingle.Process(vecIn[k]));
+}
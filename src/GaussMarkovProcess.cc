@@ -17,12 +17,24 @@
 
 #include <ignition/math/GaussMarkovProcess.hh>
 #include <ignition/math/Rand.hh>
+#include <ignition/math/RandomGenerator.hh>
 
 using namespace ignition::math;
 
 //////////////////////////////////////////////////
 class ignition::math::GaussMarkovProcessPrivate
 {
+  /// \brief Advance the process by one time step.
+  /// \param[in] _dt Time step, in seconds.
+  /// \param[in] _noise Sample of a standard normal distribution.
+  /// \return The new process value.
+  public: double Step(double _dt, double _noise)
+  {
+    this->value += this->theta * (this->mu - this->value) * _dt +
+      this->sigma * _noise;
+    return this->value;
+  }
+
   /// \brief Current process value.
   public: double value{0};
 
@@ -115,10 +127,19 @@ double GaussMarkovProcess::Update(const clock::duration &_dt)
 //////////////////////////////////////////////////
 double GaussMarkovProcess::Update(double _dt)
 {
-  this->dataPtr->value += this->dataPtr->theta *
-    (this->dataPtr->mu - this->dataPtr->value) * _dt +
-    this->dataPtr->sigma * Rand::DblNormal(0, 1);
+  return this->dataPtr->Step(_dt, Rand::DblNormal(0, 1));
+}
 
-  // Output the new value.
-  return this->dataPtr->value;
+//////////////////////////////////////////////////
+double GaussMarkovProcess::Update(const clock::duration &_dt,
+    RandomGenerator &_generator)
+{
+  // Time difference in seconds
+  return this->Update(std::chrono::duration<double>(_dt).count(), _generator);
+}
+
+//////////////////////////////////////////////////
+double GaussMarkovProcess::Update(double _dt, RandomGenerator &_generator)
+{
+  return this->dataPtr->Step(_dt, _generator.DblNormal(0, 1));
 }
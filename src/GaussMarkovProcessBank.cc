@@ -0,0 +1,276 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "ignition/math/GaussMarkovProcessBank.hh"
+#include "ignition/math/Rand.hh"
+#include "ignition/math/RandomGenerator.hh"
+
+using namespace ignition;
+using namespace math;
+
+/// \brief Private data for the GaussMarkovProcessBank class.
+class ignition::math::GaussMarkovProcessBankPrivate
+{
+  /// \brief Compute the decay and noise scale of every process for a
+  /// time step, unless they are cached for it.
+  /// \param[in] _dt Time step in seconds, positive.
+  public: void Coefficients(double _dt)
+  {
+    if (this->coefficientsValid && !(_dt < this->cachedDt) &&
+        !(_dt > this->cachedDt))
+    {
+      return;
+    }
+
+    const size_t count = this->value.size();
+    for (size_t i = 0; i < count; ++i)
+    {
+      const double rate = this->theta[i];
+      this->decay[i] = std::exp(-rate * _dt);
+
+      // Variance of the exact step. expm1 keeps precision for small
+      // theta * dt, and theta = 0 is the random walk limit.
+      const double variance = rate > 0 ?
+        -std::expm1(-2.0 * rate * _dt) / (2.0 * rate) : _dt;
+      this->scale[i] = this->sigma[i] * std::sqrt(variance);
+    }
+    this->cachedDt = _dt;
+    this->coefficientsValid = true;
+  }
+
+  /// \brief Advance all processes with the cached coefficients and the
+  /// normal values in noise.
+  public: void Step()
+  {
+    const size_t count = this->value.size();
+    double *x = this->value.data();
+    const double *m = this->mu.data();
+    const double *d = this->decay.data();
+    const double *s = this->scale.data();
+    const double *n = this->noise.data();
+    for (size_t i = 0; i < count; ++i)
+      x[i] = m[i] + (x[i] - m[i]) * d[i] + s[i] * n[i];
+  }
+
+  /// \brief Invalidate the cached coefficients.
+  public: void Invalidate()
+  {
+    this->coefficientsValid = false;
+  }
+
+  /// \brief Start values.
+  public: std::vector<double> start;
+
+  /// \brief Theta values.
+  public: std::vector<double> theta;
+
+  /// \brief Mu values.
+  public: std::vector<double> mu;
+
+  /// \brief Sigma values.
+  public: std::vector<double> sigma;
+
+  /// \brief Current values.
+  public: std::vector<double> value;
+
+  /// \brief Decay of the distance to mu over the cached time step.
+  public: std::vector<double> decay;
+
+  /// \brief Standard deviation of the noise over the cached time step.
+  public: std::vector<double> scale;
+
+  /// \brief Normal values of the current update.
+  public: std::vector<double> noise;
+
+  /// \brief Time step of the cached coefficients.
+  public: double cachedDt = 0.0;
+
+  /// \brief True if decay and scale hold the coefficients for cachedDt.
+  /// Cleared whenever theta, sigma or the number of processes changes.
+  public: bool coefficientsValid = false;
+};
+
+//////////////////////////////////////////////////
+GaussMarkovProcessBank::GaussMarkovProcessBank()
+  : dataPtr(new GaussMarkovProcessBankPrivate)
+{
+}
+
+//////////////////////////////////////////////////
+GaussMarkovProcessBank::~GaussMarkovProcessBank()
+{
+}
+
+//////////////////////////////////////////////////
+size_t GaussMarkovProcessBank::Count() const
+{
+  return this->dataPtr->value.size();
+}
+
+//////////////////////////////////////////////////
+size_t GaussMarkovProcessBank::AddProcess(double _start, double _theta,
+    double _mu, double _sigma)
+{
+  auto &d = *this->dataPtr;
+  d.start.push_back(_start);
+  d.theta.push_back(std::max(0.0, _theta));
+  d.mu.push_back(_mu);
+  d.sigma.push_back(std::max(0.0, _sigma));
+  d.value.push_back(_start);
+  d.decay.push_back(0.0);
+  d.scale.push_back(0.0);
+  d.noise.push_back(0.0);
+  d.Invalidate();
+  return d.value.size() - 1;
+}
+
+//////////////////////////////////////////////////
+bool GaussMarkovProcessBank::Set(size_t _index, double _start,
+    double _theta, double _mu, double _sigma)
+{
+  auto &d = *this->dataPtr;
+  if (_index >= d.value.size())
+    return false;
+
+  d.start[_index] = _start;
+  d.theta[_index] = std::max(0.0, _theta);
+  d.mu[_index] = _mu;
+  d.sigma[_index] = std::max(0.0, _sigma);
+  d.value[_index] = _start;
+  d.Invalidate();
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool GaussMarkovProcessBank::RemoveProcess(size_t _index)
+{
+  auto &d = *this->dataPtr;
+  if (_index >= d.value.size())
+    return false;
+
+  for (auto *array : {&d.start, &d.theta, &d.mu, &d.sigma, &d.value,
+      &d.decay, &d.scale, &d.noise})
+  {
+    (*array)[_index] = array->back();
+    array->pop_back();
+  }
+  d.Invalidate();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void GaussMarkovProcessBank::Clear()
+{
+  auto &d = *this->dataPtr;
+  for (auto *array : {&d.start, &d.theta, &d.mu, &d.sigma, &d.value,
+      &d.decay, &d.scale, &d.noise})
+  {
+    array->clear();
+  }
+  d.Invalidate();
+}
+
+//////////////////////////////////////////////////
+void GaussMarkovProcessBank::Reset()
+{
+  this->dataPtr->value = this->dataPtr->start;
+}
+
+//////////////////////////////////////////////////
+double GaussMarkovProcessBank::Start(size_t _index) const
+{
+  return _index < this->Count() ? this->dataPtr->start[_index] :
+    std::numeric_limits<double>::quiet_NaN();
+}
+
+//////////////////////////////////////////////////
+double GaussMarkovProcessBank::Theta(size_t _index) const
+{
+  return _index < this->Count() ? this->dataPtr->theta[_index] :
+    std::numeric_limits<double>::quiet_NaN();
+}
+
+//////////////////////////////////////////////////
+double GaussMarkovProcessBank::Mu(size_t _index) const
+{
+  return _index < this->Count() ? this->dataPtr->mu[_index] :
+    std::numeric_limits<double>::quiet_NaN();
+}
+
+//////////////////////////////////////////////////
+double GaussMarkovProcessBank::Sigma(size_t _index) const
+{
+  return _index < this->Count() ? this->dataPtr->sigma[_index] :
+    std::numeric_limits<double>::quiet_NaN();
+}
+
+//////////////////////////////////////////////////
+double GaussMarkovProcessBank::Value(size_t _index) const
+{
+  return _index < this->Count() ? this->dataPtr->value[_index] :
+    std::numeric_limits<double>::quiet_NaN();
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Values() const
+{
+  return this->dataPtr->value;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Update(
+    const clock::duration &_dt)
+{
+  // Time difference in seconds
+  return this->Update(std::chrono::duration<double>(_dt).count());
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Update(double _dt)
+{
+  if (_dt > 0)
+  {
+    this->dataPtr->Coefficients(_dt);
+    Rand::FillNormal(this->dataPtr->noise);
+    this->dataPtr->Step();
+  }
+  return this->dataPtr->value;
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Update(
+    const clock::duration &_dt, RandomGenerator &_generator)
+{
+  // Time difference in seconds
+  return this->Update(std::chrono::duration<double>(_dt).count(), _generator);
+}
+
+//////////////////////////////////////////////////
+const std::vector<double> &GaussMarkovProcessBank::Update(double _dt,
+    RandomGenerator &_generator)
+{
+  if (_dt > 0)
+  {
+    this->dataPtr->Coefficients(_dt);
+    _generator.FillNormal(this->dataPtr->noise);
+    this->dataPtr->Step();
+  }
+  return this->dataPtr->value;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/GaussMarkovProcessBank.hh"
+#include "ignition/math/RandomGenerator.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(GaussMarkovProcessBankTest, Processes)
+{
+  math::GaussMarkovProcessBank bank;
+  EXPECT_EQ(bank.Count(), 0u);
+  EXPECT_TRUE(bank.Values().empty());
+
+  EXPECT_EQ(bank.AddProcess(1.0, 2.0, 3.0, 4.0), 0u);
+  EXPECT_EQ(bank.AddProcess(5.0, -1.0, 6.0, -2.0), 1u);
+  EXPECT_EQ(bank.Count(), 2u);
+  EXPECT_DOUBLE_EQ(bank.Start(0), 1.0);
+  EXPECT_DOUBLE_EQ(bank.Theta(0), 2.0);
+  EXPECT_DOUBLE_EQ(bank.Mu(0), 3.0);
+  EXPECT_DOUBLE_EQ(bank.Sigma(0), 4.0);
+  EXPECT_DOUBLE_EQ(bank.Value(0), 1.0);
+
+  // Negative theta and sigma are clamped
+  EXPECT_DOUBLE_EQ(bank.Theta(1), 0.0);
+  EXPECT_DOUBLE_EQ(bank.Sigma(1), 0.0);
+
+  EXPECT_TRUE(std::isnan(bank.Value(2)));
+  EXPECT_TRUE(std::isnan(bank.Start(2)));
+  EXPECT_TRUE(std::isnan(bank.Theta(2)));
+  EXPECT_TRUE(std::isnan(bank.Mu(2)));
+  EXPECT_TRUE(std::isnan(bank.Sigma(2)));
+
+  EXPECT_TRUE(bank.Set(1, 7.0, 0.5, 8.0, 0.0));
+  EXPECT_FALSE(bank.Set(2, 7.0, 0.5, 8.0, 0.0));
+  EXPECT_DOUBLE_EQ(bank.Value(1), 7.0);
+
+  // The last process moves to the removed index
+  EXPECT_TRUE(bank.RemoveProcess(0));
+  EXPECT_FALSE(bank.RemoveProcess(1));
+  EXPECT_EQ(bank.Count(), 1u);
+  EXPECT_DOUBLE_EQ(bank.Start(0), 7.0);
+  EXPECT_DOUBLE_EQ(bank.Mu(0), 8.0);
+
+  bank.Clear();
+  EXPECT_EQ(bank.Count(), 0u);
+  bank.Update(0.1);
+}
+
+//////////////////////////////////////////////////
+TEST(GaussMarkovProcessBankTest, Deterministic)
+{
+  // Without noise, processes decay exactly towards mu for any steps
+  math::GaussMarkovProcessBank bank;
+  bank.AddProcess(10.0, 0.5, 2.0, 0.0);
+  bank.AddProcess(-3.0, 4.0, 1.0, 0.0);
+  bank.AddProcess(1.5, 0.0, 7.0, 0.0);
+
+  double t = 0;
+  for (double dt : {0.1, 0.1, 0.25, 1.0, 0.01, 0.01})
+  {
+    bank.Update(dt);
+    t += dt;
+  }
+  EXPECT_NEAR(bank.Value(0), 2.0 + 8.0 * std::exp(-0.5 * t), 1e-12);
+  EXPECT_NEAR(bank.Value(1), 1.0 - 4.0 * std::exp(-4.0 * t), 1e-12);
+  EXPECT_DOUBLE_EQ(bank.Value(2), 1.5);
+
+  // Steps that are not positive do nothing
+  const std::vector<double> before = bank.Values();
+  EXPECT_EQ(bank.Update(0.0), before);
+  EXPECT_EQ(bank.Update(-1.0), before);
+
+  bank.Update(std::chrono::milliseconds(500));
+  EXPECT_NEAR(bank.Value(0), 2.0 + 8.0 * std::exp(-0.5 * (t + 0.5)),
+      1e-12);
+
+  bank.Reset();
+  EXPECT_DOUBLE_EQ(bank.Value(0), 10.0);
+  EXPECT_DOUBLE_EQ(bank.Value(1), -3.0);
+}
+
+//////////////////////////////////////////////////
+TEST(GaussMarkovProcessBankTest, Variance)
+{
+  // The stationary variance is sigma^2 / (2 theta), even with steps much
+  // longer than 1 / theta.
+  const size_t count = 20000;
+  math::GaussMarkovProcessBank stationary;
+  math::GaussMarkovProcessBank walk;
+  for (size_t i = 0; i < count; ++i)
+  {
+    stationary.AddProcess(1.0, 2.0, 1.0, 0.5);
+    walk.AddProcess(0.0, 0.0, 0.0, 0.5);
+  }
+
+  math::RandomGenerator generator(3);
+  for (int i = 0; i < 20; ++i)
+  {
+    stationary.Update(1.0, generator);
+    walk.Update(0.2, generator);
+  }
+
+  auto variance = [](const std::vector<double> &_values, double _mean)
+  {
+    double sum = 0;
+    for (double value : _values)
+      sum += (value - _mean) * (value - _mean);
+    return sum / _values.size();
+  };
+  EXPECT_NEAR(variance(stationary.Values(), 1.0), 0.0625, 0.003);
+
+  // A random walk has variance sigma^2 t
+  EXPECT_NEAR(variance(walk.Values(), 0.0), 1.0, 0.04);
+
+  // The same generator seed gives the same values
+  math::GaussMarkovProcessBank a;
+  math::GaussMarkovProcessBank b;
+  for (int i = 0; i < 10; ++i)
+  {
+    a.AddProcess(0.0, 1.0, 0.0, 1.0);
+    b.AddProcess(0.0, 1.0, 0.0, 1.0);
+  }
+  math::RandomGenerator genA(9);
+  math::RandomGenerator genB(9);
+  a.Update(std::chrono::milliseconds(10), genA);
+  b.Update(0.01, genB);
+  EXPECT_EQ(a.Values(), b.Values());
+
+  // Rand is used by default
+  a.Update(0.01);
+  EXPECT_NE(a.Values(), b.Values());
+}
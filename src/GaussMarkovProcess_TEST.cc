@@ -20,6 +20,7 @@
 #include "ignition/math/GaussMarkovProcess.hh"
 #include "ignition/math/Helpers.hh"
 #include "ignition/math/Rand.hh"
+#include "ignition/math/RandomGenerator.hh"
 
 using namespace ignition;
 using namespace math;
@@ -103,3 +104,29 @@ TEST(GaussMarkovProcessTest, Noise)
   EXPECT_NEAR(-4.118732, gmp.Value(), 1e-4);
 #endif
 }
+
+/////////////////////////////////////////////////
+TEST(GaussMarkovProcessTest, Generator)
+{
+  // A process with its own generator gives the same values as the process
+  // using Rand with the same seed.
+  GaussMarkovProcess withRand(20.2, 0.1, 0, 0.5);
+  GaussMarkovProcess withGenerator(20.2, 0.1, 0, 0.5);
+  clock::duration dt = std::chrono::milliseconds(100);
+  Rand::Seed(1001);
+  RandomGenerator generator(1001);
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    EXPECT_DOUBLE_EQ(withRand.Update(dt),
+        withGenerator.Update(dt, generator));
+  }
+
+  // Independent streams give independent processes
+  GaussMarkovProcess a(0, 0.1, 0, 0.5);
+  GaussMarkovProcess b(0, 0.1, 0, 0.5);
+  RandomGenerator streamA(1001, 1);
+  RandomGenerator streamB(1001, 2);
+  for (int i = 0; i < 10; ++i)
+    EXPECT_NE(a.Update(0.1, streamA), b.Update(0.1, streamB));
+}
@@ -17,14 +17,522 @@
 
 #include <ignition/math/Kmeans.hh>
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
+#include <thread>
 
-#include <ignition/math/Rand.hh>
+#include <ignition/math/RandomGenerator.hh>
+#include "ChunkPool.hh"
 #include "KmeansPrivate.hh"
 
 using namespace ignition;
 using namespace math;
 
+namespace
+{
+//////////////////////////////////////////////////
+/// \brief Find the closest and second closest centroids to a point.
+/// \param[in] _p Point.
+/// \param[in] _centroids Centroids.
+/// \param[out] _best Squared distance to the closest centroid.
+/// \param[out] _second Squared distance to the second closest centroid,
+/// or infinity if there is a single centroid.
+/// \return Index of the closest centroid.
+unsigned int Nearest(const Vector3d &_p,
+    const std::vector<Vector3d> &_centroids, double &_best, double &_second)
+{
+  _best = HUGE_VAL;
+  _second = HUGE_VAL;
+  unsigned int minIdx = 0;
+  for (auto i = 0u; i < _centroids.size(); ++i)
+  {
+    const double d = (_p - _centroids[i]).SquaredLength();
+    if (d < _best)
+    {
+      _second = _best;
+      _best = d;
+      minIdx = i;
+    }
+    else if (d < _second)
+    {
+      _second = d;
+    }
+  }
+  return minIdx;
+}
+
+//////////////////////////////////////////////////
+/// \brief Compute half the distance from each centroid to the closest
+/// other centroid. A point closer to its centroid than this cannot be
+/// closer to any other centroid.
+/// \param[in] _centroids Centroids.
+/// \param[out] _halfGap Half distances, infinity for a single centroid.
+void CentroidGaps(const std::vector<Vector3d> &_centroids,
+    std::vector<double> &_halfGap)
+{
+  for (auto i = 0u; i < _centroids.size(); ++i)
+  {
+    double min = HUGE_VAL;
+    for (auto j = 0u; j < _centroids.size(); ++j)
+    {
+      if (i != j)
+        min = std::min(min, (_centroids[i] - _centroids[j]).SquaredLength());
+    }
+    _halfGap[i] = 0.5 * std::sqrt(min);
+  }
+}
+
+//////////////////////////////////////////////////
+/// \brief Read-only view of points stored as an array of points.
+template<typename T>
+class PointArray
+{
+  /// \brief Constructor.
+  /// \param[in] _points Array of points.
+  /// \param[in] _count Number of points.
+  public: PointArray(const Vector3<T> *_points, size_t _count)
+    : points(_points), count(_count)
+  {
+  }
+
+  /// \brief Get the number of points.
+  /// \return Number of points.
+  public: size_t size() const
+  {
+    return this->count;
+  }
+
+  /// \brief Get a point in double precision.
+  /// \param[in] _i Index of the point.
+  /// \return The point.
+  public: Vector3d operator[](size_t _i) const
+  {
+    const Vector3<T> &p = this->points[_i];
+    return Vector3d(p.X(), p.Y(), p.Z());
+  }
+
+  /// \brief Points.
+  private: const Vector3<T> *points;
+
+  /// \brief Number of points.
+  private: size_t count;
+};
+
+//////////////////////////////////////////////////
+/// \brief Read-only view of points stored as one array per coordinate.
+template<typename T>
+class CoordinateArrays
+{
+  /// \brief Constructor.
+  /// \param[in] _x X coordinates.
+  /// \param[in] _y Y coordinates.
+  /// \param[in] _z Z coordinates.
+  /// \param[in] _count Number of points.
+  public: CoordinateArrays(const T *_x, const T *_y, const T *_z,
+              size_t _count)
+    : x(_x), y(_y), z(_z), count(_count)
+  {
+  }
+
+  /// \brief Get the number of points.
+  /// \return Number of points.
+  public: size_t size() const
+  {
+    return this->count;
+  }
+
+  /// \brief Get a point in double precision.
+  /// \param[in] _i Index of the point.
+  /// \return The point.
+  public: Vector3d operator[](size_t _i) const
+  {
+    return Vector3d(this->x[_i], this->y[_i], this->z[_i]);
+  }
+
+  /// \brief X coordinates.
+  private: const T *x;
+
+  /// \brief Y coordinates.
+  private: const T *y;
+
+  /// \brief Z coordinates.
+  private: const T *z;
+
+  /// \brief Number of points.
+  private: size_t count;
+};
+
+//////////////////////////////////////////////////
+/// \brief Steps of Kmeans::Cluster, run over a fixed partition of the
+/// observations into chunks. Each chunk produces partial results that are
+/// merged in chunk order. The partition only depends on the number of
+/// observations, so results are the same for any number of threads.
+/// \tparam Points View of the observations, PointArray or
+/// CoordinateArrays.
+template<typename Points>
+class Solver
+{
+  /// \brief Constructor.
+  /// \param[in] _obs Observations.
+  /// \param[in] _k Number of clusters.
+  /// \param[in] _threads Number of threads.
+  public: Solver(const Points &_obs, unsigned int _k,
+              unsigned int _threads)
+    : obs(_obs), k(_k),
+      chunkSize(std::max<size_t>(4096, (_obs.size() + 255) / 256)),
+      chunks((_obs.size() + this->chunkSize - 1) / this->chunkSize),
+      pool(static_cast<unsigned int>(
+            std::min<size_t>(std::max(_threads, 1u), this->chunks)))
+  {
+  }
+
+  /// \brief Choose initial centroids with greedy k-means++: the first one
+  /// is a random observation, and each next one is the best of a few
+  /// candidates drawn with probability proportional to their squared
+  /// distance to the closest centroid chosen so far. The best candidate
+  /// is the one that most reduces the sum of these squared distances.
+  /// \param[in] _seed Seed of the random generator.
+  /// \param[out] _centroids Initial centroids.
+  public: void SeedCentroids(unsigned int _seed,
+              std::vector<Vector3d> &_centroids)
+  {
+    RandomGenerator generator(_seed);
+    const size_t count = this->obs.size();
+    auto pick = [&]()
+    {
+      return std::min(count - 1, static_cast<size_t>(
+            generator.DblUniform(0, static_cast<double>(count))));
+    };
+
+    // Squared distance of each observation to the closest centroid, and
+    // its sum over each chunk, for the chosen centroids and a candidate.
+    std::vector<double> dist(count, HUGE_VAL);
+    std::vector<double> chunkTotal(this->chunks);
+    std::vector<double> candidateDist(count);
+    std::vector<double> candidateTotal(this->chunks);
+    auto evaluate = [&](size_t _candidate)
+    {
+      const Vector3d p = this->obs[_candidate];
+      this->pool.Run(this->chunks, [&](size_t _c)
+      {
+        double sum = 0;
+        const size_t end = this->End(_c);
+        for (size_t i = _c * this->chunkSize; i < end; ++i)
+        {
+          candidateDist[i] = std::min(dist[i],
+              (this->obs[i] - p).SquaredLength());
+          sum += candidateDist[i];
+        }
+        candidateTotal[_c] = sum;
+      });
+
+      double total = 0;
+      for (double sum : candidateTotal)
+        total += sum;
+      return total;
+    };
+
+    const size_t firstIdx = pick();
+    _centroids.clear();
+    _centroids.push_back(this->obs[firstIdx]);
+    double total = evaluate(firstIdx);
+    std::swap(dist, candidateDist);
+    std::swap(chunkTotal, candidateTotal);
+
+    // Number of candidates of each step, as in scikit-learn
+    const int trials = 2 + static_cast<int>(std::log(this->k));
+    std::vector<double> bestDist(count);
+    std::vector<double> bestTotal(this->chunks);
+
+    while (_centroids.size() < this->k)
+    {
+      size_t best = 0;
+      double bestSum = HUGE_VAL;
+      for (int trial = 0; trial < trials; ++trial)
+      {
+        // If all observations coincide with centroids, any one will do.
+        size_t candidate = pick();
+        if (total > 0)
+        {
+          // Find the chunk of the target, then the observation in it.
+          const double target = generator.DblUniform(0, total);
+          size_t c = 0;
+          double sum = 0;
+          while (c + 1 < this->chunks && sum + chunkTotal[c] <= target)
+            sum += chunkTotal[c++];
+          for (size_t i = c * this->chunkSize; i < count; ++i)
+          {
+            if (dist[i] <= 0)
+              continue;
+            candidate = i;
+            sum += dist[i];
+            if (sum > target)
+              break;
+          }
+        }
+
+        const double candidateSum = evaluate(candidate);
+        if (candidateSum < bestSum)
+        {
+          best = candidate;
+          bestSum = candidateSum;
+          std::swap(bestDist, candidateDist);
+          std::swap(bestTotal, candidateTotal);
+        }
+      }
+
+      _centroids.push_back(this->obs[best]);
+      std::swap(dist, bestDist);
+      std::swap(chunkTotal, bestTotal);
+      total = bestSum;
+    }
+  }
+
+  /// \brief Label each observation with its closest centroid, and sum
+  /// the observations of each cluster.
+  ///
+  /// An observation keeps its label without a scan over all centroids if
+  /// its upper bound shows that no other centroid can be closer.
+  /// \param[in] _centroids Centroids.
+  /// \param[in] _first True if the bounds are not valid yet.
+  /// \param[in,out] _labels Label of each observation.
+  /// \param[in,out] _upper Upper bound of the distance of each observation
+  /// to its centroid.
+  /// \param[in,out] _lower Lower bound of the distance of each observation
+  /// to any other centroid.
+  /// \param[out] _sums Sum of the observations of each cluster.
+  /// \param[out] _counters Number of observations of each cluster.
+  /// \return Number of observations whose label changed.
+  public: size_t Assign(const std::vector<Vector3d> &_centroids,
+              bool _first, unsigned int *_labels,
+              std::vector<double> &_upper, std::vector<double> &_lower,
+              std::vector<Vector3d> &_sums,
+              std::vector<unsigned int> &_counters)
+  {
+    const size_t kk = this->k;
+    this->halfGap.resize(kk);
+    this->partialSums.resize(this->chunks * kk);
+    this->partialCounters.resize(this->chunks * kk);
+    this->partialChanged.resize(this->chunks);
+    CentroidGaps(_centroids, this->halfGap);
+
+    this->pool.Run(this->chunks, [&](size_t _c)
+    {
+      Vector3d *sums = &this->partialSums[_c * kk];
+      unsigned int *counters = &this->partialCounters[_c * kk];
+      std::fill(sums, sums + kk, Vector3d::Zero);
+      std::fill(counters, counters + kk, 0u);
+
+      size_t changed = 0;
+      const size_t end = this->End(_c);
+      for (size_t i = _c * this->chunkSize; i < end; ++i)
+      {
+        const Vector3d p = this->obs[i];
+        unsigned int label = _labels[i];
+        const double bound = std::max(this->halfGap[label], _lower[i]);
+        if (_first || _upper[i] > bound)
+        {
+          if (!_first)
+            _upper[i] = std::sqrt((p - _centroids[label]).SquaredLength());
+          if (_first || _upper[i] > bound)
+          {
+            double best;
+            double second;
+            label = Nearest(p, _centroids, best, second);
+            _upper[i] = std::sqrt(best);
+            _lower[i] = std::sqrt(second);
+          }
+        }
+        if (_labels[i] != label)
+        {
+          _labels[i] = label;
+          changed++;
+        }
+        sums[label] += p;
+        counters[label]++;
+      }
+      this->partialChanged[_c] = changed;
+    });
+
+    // Merge in chunk order
+    size_t changed = 0;
+    std::fill(_sums.begin(), _sums.end(), Vector3d::Zero);
+    std::fill(_counters.begin(), _counters.end(), 0u);
+    for (size_t c = 0; c < this->chunks; ++c)
+    {
+      for (size_t j = 0; j < kk; ++j)
+      {
+        _sums[j] += this->partialSums[c * kk + j];
+        _counters[j] += this->partialCounters[c * kk + j];
+      }
+      changed += this->partialChanged[c];
+    }
+    return changed;
+  }
+
+  /// \brief Loosen the distance bounds of the observations after the
+  /// centroids moved.
+  /// \param[in] _drift Distance moved by each centroid.
+  /// \param[in] _labels Label of each observation.
+  /// \param[in,out] _upper Upper bounds, increased by the move of the
+  /// centroid of each observation.
+  /// \param[in,out] _lower Lower bounds, decreased by the largest move of
+  /// the other centroids.
+  public: void UpdateBounds(const std::vector<double> &_drift,
+              const unsigned int *_labels, std::vector<double> &_upper,
+              std::vector<double> &_lower)
+  {
+    unsigned int maxIdx = 0;
+    double maxDrift = 0;
+    double secondDrift = 0;
+    for (auto i = 0u; i < _drift.size(); ++i)
+    {
+      if (_drift[i] > maxDrift)
+      {
+        secondDrift = maxDrift;
+        maxDrift = _drift[i];
+        maxIdx = i;
+      }
+      else if (_drift[i] > secondDrift)
+      {
+        secondDrift = _drift[i];
+      }
+    }
+
+    this->pool.Run(this->chunks, [&](size_t _c)
+    {
+      const size_t end = this->End(_c);
+      for (size_t i = _c * this->chunkSize; i < end; ++i)
+      {
+        _upper[i] += _drift[_labels[i]];
+        _lower[i] -= _labels[i] == maxIdx ? secondDrift : maxDrift;
+      }
+    });
+  }
+
+  /// \brief Get the end of a chunk.
+  /// \param[in] _c Chunk index.
+  /// \return Index after the last observation of the chunk.
+  private: size_t End(size_t _c) const
+  {
+    return std::min(this->obs.size(), (_c + 1) * this->chunkSize);
+  }
+
+  /// \brief Observations.
+  private: Points obs;
+
+  /// \brief Number of clusters.
+  private: size_t k;
+
+  /// \brief Number of observations of each chunk but the last.
+  private: size_t chunkSize;
+
+  /// \brief Number of chunks.
+  private: size_t chunks;
+
+  /// \brief Threads.
+  private: ChunkPool pool;
+
+  /// \brief Half the distance from each centroid to the closest other.
+  private: std::vector<double> halfGap;
+
+  /// \brief Sum of the observations of each cluster in each chunk.
+  private: std::vector<Vector3d> partialSums;
+
+  /// \brief Number of observations of each cluster in each chunk.
+  private: std::vector<unsigned int> partialCounters;
+
+  /// \brief Number of changed labels in each chunk.
+  private: std::vector<size_t> partialChanged;
+};
+
+//////////////////////////////////////////////////
+/// \brief Check the number of clusters against the number of points.
+/// \param[in] _count Number of points.
+/// \param[in] _k Number of clusters.
+/// \return True if the number of clusters is valid.
+bool CheckClusters(size_t _count, int _k)
+{
+  if (_k <= 0)
+  {
+    std::cerr << "Kmeans error: The number of clusters has to"
+              << " be positive but its value is [" << _k << "]"
+              << std::endl;
+    return false;
+  }
+
+  if (static_cast<size_t>(_k) > _count)
+  {
+    std::cerr << "Kmeans error: The number of clusters [" << _k << "] has to be"
+              << " lower or equal to the number of observations ["
+              << _count << "]" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+/// \brief Run k-means on a set of points.
+/// \param[in] _obs View of the points.
+/// \param[in] _k Number of clusters, valid for the number of points.
+/// \param[in] _seed Seed of the initial centroids.
+/// \param[in] _threads Number of threads.
+/// \param[out] _centroids Centroids.
+/// \param[out] _labels Array of labels, one per point.
+template<typename Points>
+void Lloyd(const Points &_obs, unsigned int _k, unsigned int _seed,
+    unsigned int _threads, std::vector<Vector3d> &_centroids,
+    unsigned int *_labels)
+{
+  const size_t count = _obs.size();
+  Solver<Points> solver(_obs, _k, _threads);
+  size_t changed = 0;
+
+  // Distance bounds of each point, and the sum and number of points of
+  // each cluster.
+  std::fill(_labels, _labels + count, 0u);
+  std::vector<double> upper(count);
+  std::vector<double> lower(count);
+  std::vector<Vector3d> sums(_k);
+  std::vector<unsigned int> counters(_k);
+  solver.SeedCentroids(_seed, _centroids);
+
+  // Distance moved by each centroid in the last update.
+  std::vector<double> drift(_k);
+  bool first = true;
+
+  do
+  {
+    // Update the labels containing the closest centroid for each point,
+    // and the sums and counters of each cluster.
+    changed = solver.Assign(_centroids, first, _labels, upper, lower, sums,
+        counters);
+
+    // Update the centroids. An empty cluster keeps its centroid.
+    for (auto i = 0u; i < _centroids.size(); ++i)
+    {
+      drift[i] = 0;
+      if (counters[i] > 0)
+      {
+        const Vector3d centroid = sums[i] / counters[i];
+        drift[i] = centroid.Distance(_centroids[i]);
+        _centroids[i] = centroid;
+      }
+    }
+    solver.UpdateBounds(drift, _labels, upper, lower);
+    first = false;
+  }
+  while (changed > (count >> 10)); // NOLINT
+}
+}
+
+//////////////////////////////////////////////////
+Kmeans::Kmeans()
+: dataPtr(new KmeansPrivate)
+{
+}
+
 //////////////////////////////////////////////////
 Kmeans::Kmeans(const std::vector<Vector3d> &_obs)
 : dataPtr(new KmeansPrivate)
@@ -71,6 +579,32 @@ bool Kmeans::AppendObservations(const std::vector<Vector3d> &_obs)
   return true;
 }
 
+//////////////////////////////////////////////////
+void Kmeans::Seed(unsigned int _seed)
+{
+  this->dataPtr->seed = _seed;
+}
+
+//////////////////////////////////////////////////
+unsigned int Kmeans::Seed() const
+{
+  return this->dataPtr->seed;
+}
+
+//////////////////////////////////////////////////
+void Kmeans::Threads(unsigned int _threads)
+{
+  if (_threads == 0)
+    _threads = std::max(1u, std::thread::hardware_concurrency());
+  this->dataPtr->threads = _threads;
+}
+
+//////////////////////////////////////////////////
+unsigned int Kmeans::Threads() const
+{
+  return this->dataPtr->threads;
+}
+
 //////////////////////////////////////////////////
 bool Kmeans::Cluster(int _k,
                      std::vector<Vector3d> &_centroids,
@@ -83,92 +617,103 @@ bool Kmeans::Cluster(int _k,
     return false;
   }
 
-  if (_k <= 0)
-  {
-    std::cerr << "Kmeans error: The number of clusters has to"
-              << " be positive but its value is [" << _k << "]"
-              << std::endl;
+  if (!CheckClusters(this->dataPtr->obs.size(), _k))
     return false;
-  }
 
-  if (_k > static_cast<int>(this->dataPtr->obs.size()))
+  _labels.resize(this->dataPtr->obs.size());
+  Lloyd(PointArray<double>(this->dataPtr->obs.data(),
+        this->dataPtr->obs.size()), _k, this->dataPtr->seed,
+      this->dataPtr->threads, _centroids, _labels.data());
+  this->dataPtr->centroids = _centroids;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::Cluster(const Vector3d *_points, size_t _count, int _k,
+                     std::vector<Vector3d> &_centroids,
+                     unsigned int *_labels)
+{
+  if (!_points || !_labels)
   {
-    std::cerr << "Kmeans error: The number of clusters [" << _k << "] has to be"
-              << " lower or equal to the number of observations ["
-              << this->dataPtr->obs.size() << "]" << std::endl;
+    std::cerr << "Kmeans error: null points or labels" << std::endl;
     return false;
   }
 
-  size_t changed = 0;
+  if (!CheckClusters(_count, _k))
+    return false;
 
-  // Initialize the size of the vectors;
-  this->dataPtr->centroids.clear();
-  this->dataPtr->labels.resize(this->dataPtr->obs.size());
-  this->dataPtr->sums.resize(_k);
-  this->dataPtr->counters.resize(_k);
+  Lloyd(PointArray<double>(_points, _count), _k, this->dataPtr->seed,
+      this->dataPtr->threads, _centroids, _labels);
+  this->dataPtr->centroids = _centroids;
+  return true;
+}
 
-  for (auto i = 0; i < _k; ++i)
+//////////////////////////////////////////////////
+bool Kmeans::Cluster(const Vector3f *_points, size_t _count, int _k,
+                     std::vector<Vector3d> &_centroids,
+                     unsigned int *_labels)
+{
+  if (!_points || !_labels)
   {
-    // Choose a random observation and make sure it has not been chosen before.
-    // Note: This is not really random but it's faster than choosing a random
-    // one and verifying that it was not taken before.
-    this->dataPtr->centroids.push_back(this->dataPtr->obs[i]);
+    std::cerr << "Kmeans error: null points or labels" << std::endl;
+    return false;
   }
 
-  // Initialize labels.
-  for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
-    this->dataPtr->labels[i] = 0;
+  if (!CheckClusters(_count, _k))
+    return false;
+
+  Lloyd(PointArray<float>(_points, _count), _k, this->dataPtr->seed,
+      this->dataPtr->threads, _centroids, _labels);
+  this->dataPtr->centroids = _centroids;
+  return true;
+}
 
-  do
+//////////////////////////////////////////////////
+bool Kmeans::Cluster(const double *_x, const double *_y, const double *_z,
+                     size_t _count, int _k,
+                     std::vector<Vector3d> &_centroids,
+                     unsigned int *_labels)
+{
+  if (!_x || !_y || !_z || !_labels)
   {
-    // Reset sums and counters.
-    for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
-    {
-      this->dataPtr->sums[i] = Vector3d::Zero;
-      this->dataPtr->counters[i] = 0;
-    }
-    changed = 0;
+    std::cerr << "Kmeans error: null coordinates or labels" << std::endl;
+    return false;
+  }
 
-    for (auto i = 0u; i < this->dataPtr->obs.size(); ++i)
-    {
-      // Update the labels containing the closest centroid for each point.
-      auto label = this->ClosestCentroid(this->dataPtr->obs[i]);
-      if (this->dataPtr->labels[i] != label)
-      {
-        this->dataPtr->labels[i] = label;
-        changed++;
-      }
-      this->dataPtr->sums[label] += this->dataPtr->obs[i];
-      this->dataPtr->counters[label]++;
-    }
+  if (!CheckClusters(_count, _k))
+    return false;
 
-    // Update the centroids.
-    for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
-    {
-      this->dataPtr->centroids[i] =
-        this->dataPtr->sums[i] / this->dataPtr->counters[i];
-    }
+  Lloyd(CoordinateArrays<double>(_x, _y, _z, _count), _k,
+      this->dataPtr->seed, this->dataPtr->threads, _centroids, _labels);
+  this->dataPtr->centroids = _centroids;
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool Kmeans::Cluster(const float *_x, const float *_y, const float *_z,
+                     size_t _count, int _k,
+                     std::vector<Vector3d> &_centroids,
+                     unsigned int *_labels)
+{
+  if (!_x || !_y || !_z || !_labels)
+  {
+    std::cerr << "Kmeans error: null coordinates or labels" << std::endl;
+    return false;
   }
-  while (changed > (this->dataPtr->obs.size() >> 10)); // NOLINT
 
-  _centroids = this->dataPtr->centroids;
-  _labels = this->dataPtr->labels;
+  if (!CheckClusters(_count, _k))
+    return false;
+
+  Lloyd(CoordinateArrays<float>(_x, _y, _z, _count), _k,
+      this->dataPtr->seed, this->dataPtr->threads, _centroids, _labels);
+  this->dataPtr->centroids = _centroids;
   return true;
 }
 
 //////////////////////////////////////////////////
 unsigned int Kmeans::ClosestCentroid(const Vector3d &_p) const
 {
-  double min = HUGE_VAL;
-  unsigned int minIdx = 0;
-  for (auto i = 0u; i < this->dataPtr->centroids.size(); ++i)
-  {
-    double d = _p.Distance(this->dataPtr->centroids[i]);
-    if (d < min)
-    {
-      min = d;
-      minIdx = i;
-    }
-  }
-  return minIdx;
+  double best;
+  double second;
+  return Nearest(_p, this->dataPtr->centroids, best, second);
 }
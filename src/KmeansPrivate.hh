@@ -35,17 +35,14 @@ namespace ignition
       /// \brief Observations.
       public: std::vector<Vector3d> obs;
 
-      /// \brief Centroids.
+      /// \brief Centroids of the last Cluster call.
       public: std::vector<Vector3d> centroids;
 
-      /// \brief Each element stores the cluster to which observation i belongs.
-      public: std::vector<unsigned int> labels;
+      /// \brief Seed used to choose the initial centroids.
+      public: unsigned int seed = 0;
 
-      /// \brief Used to calculate the centroid of each partition.
-      public: std::vector<Vector3d> sums;
-
-      /// \brief Counts the number of observations contained in each partition.
-      public: std::vector<unsigned int> counters;
+      /// \brief Number of threads used by Cluster.
+      public: unsigned int threads = 1;
     };
     }
   }
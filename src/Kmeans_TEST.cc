@@ -18,6 +18,7 @@
 #include <gtest/gtest.h>
 #include <vector>
 #include "ignition/math/Kmeans.hh"
+#include "ignition/math/RandomGenerator.hh"
 
 using namespace ignition;
 
@@ -140,3 +141,168 @@ TEST(KmeansTest, Append)
   std::vector<math::Vector3d> emptyVector;
   EXPECT_FALSE(kmeans.AppendObservations(emptyVector));
 }
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, Seed)
+{
+  // Sorted blobs, on which taking the first k observations as initial
+  // centroids would put them all in the first blob.
+  std::vector<math::Vector3d> obs;
+  for (int blob = 0; blob < 8; ++blob)
+  {
+    for (int i = 0; i < 100; ++i)
+    {
+      obs.push_back(math::Vector3d(10.0 * blob + 0.01 * i,
+          0.1 * (i % 7), 0.1 * (i % 3)));
+    }
+  }
+
+  math::Kmeans kmeans(obs);
+  EXPECT_EQ(kmeans.Seed(), 0u);
+  kmeans.Seed(5);
+  EXPECT_EQ(kmeans.Seed(), 5u);
+
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels;
+  ASSERT_TRUE(kmeans.Cluster(8, centroids, labels));
+  ASSERT_EQ(labels.size(), obs.size());
+
+  // Every blob is its own cluster
+  for (int blob = 0; blob < 8; ++blob)
+  {
+    for (int i = 1; i < 100; ++i)
+      EXPECT_EQ(labels[blob * 100 + i], labels[blob * 100]);
+    for (int other = 0; other < blob; ++other)
+      EXPECT_NE(labels[blob * 100], labels[other * 100]);
+  }
+
+  // With fewer than 1024 observations, clustering stops when no label
+  // changes, so each observation is labeled with its closest centroid.
+  for (size_t i = 0; i < obs.size(); ++i)
+  {
+    for (size_t j = 0; j < centroids.size(); ++j)
+    {
+      EXPECT_LE(obs[i].Distance(centroids[labels[i]]),
+          obs[i].Distance(centroids[j]));
+    }
+  }
+
+  // The same seed gives the same clusters
+  std::vector<math::Vector3d> centroids2;
+  std::vector<unsigned int> labels2;
+  ASSERT_TRUE(kmeans.Cluster(8, centroids2, labels2));
+  EXPECT_EQ(centroids, centroids2);
+  EXPECT_EQ(labels, labels2);
+
+  // A single cluster is the mean of all observations
+  ASSERT_TRUE(kmeans.Cluster(1, centroids, labels));
+  EXPECT_NEAR(centroids[0].X(), 35.495, 1e-9);
+
+  // Duplicate observations
+  math::Kmeans same(std::vector<math::Vector3d>(10, math::Vector3d::One));
+  ASSERT_TRUE(same.Cluster(3, centroids, labels));
+  for (const auto &centroid : centroids)
+    EXPECT_EQ(centroid, math::Vector3d::One);
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, Threads)
+{
+  // Enough observations for several chunks
+  math::RandomGenerator generator(4);
+  std::vector<math::Vector3d> obs(50000);
+  for (auto &p : obs)
+  {
+    p.Set(generator.DblUniform(0, 10), generator.DblNormal(0, 2),
+        generator.IntUniform(0, 4));
+  }
+
+  math::Kmeans kmeans(obs);
+  EXPECT_EQ(kmeans.Threads(), 1u);
+  std::vector<math::Vector3d> serialCentroids;
+  std::vector<unsigned int> serialLabels;
+  ASSERT_TRUE(kmeans.Cluster(20, serialCentroids, serialLabels));
+
+  // Results are identical for any number of threads
+  for (unsigned int threads : {2u, 3u, 8u, 0u})
+  {
+    kmeans.Threads(threads);
+    EXPECT_GE(kmeans.Threads(), 1u);
+    std::vector<math::Vector3d> centroids;
+    std::vector<unsigned int> labels;
+    ASSERT_TRUE(kmeans.Cluster(20, centroids, labels));
+    ASSERT_EQ(centroids.size(), serialCentroids.size());
+    for (size_t i = 0; i < centroids.size(); ++i)
+    {
+      EXPECT_EQ(centroids[i].X(), serialCentroids[i].X());
+      EXPECT_EQ(centroids[i].Y(), serialCentroids[i].Y());
+      EXPECT_EQ(centroids[i].Z(), serialCentroids[i].Z());
+    }
+    EXPECT_EQ(labels, serialLabels);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(KmeansTest, ExternalPoints)
+{
+  math::RandomGenerator generator(6);
+  std::vector<math::Vector3d> obs(10000);
+  std::vector<math::Vector3f> obsf(obs.size());
+  std::vector<double> x(obs.size()), y(obs.size()), z(obs.size());
+  std::vector<float> xf(obs.size()), yf(obs.size()), zf(obs.size());
+  for (size_t i = 0; i < obs.size(); ++i)
+  {
+    // Coordinates exactly representable as float
+    obs[i].Set(generator.IntUniform(0, 100) * 0.25,
+        generator.IntUniform(-50, 50) * 0.5, generator.IntUniform(0, 4));
+    obsf[i].Set(obs[i].X(), obs[i].Y(), obs[i].Z());
+    x[i] = xf[i] = obs[i].X();
+    y[i] = yf[i] = obs[i].Y();
+    z[i] = zf[i] = obs[i].Z();
+  }
+
+  math::Kmeans copied(obs);
+  std::vector<math::Vector3d> expectedCentroids;
+  std::vector<unsigned int> expectedLabels;
+  ASSERT_TRUE(copied.Cluster(8, expectedCentroids, expectedLabels));
+
+  // Every layout gives the same result as the stored observations
+  math::Kmeans kmeans;
+  std::vector<math::Vector3d> centroids;
+  std::vector<unsigned int> labels(obs.size());
+  auto check = [&]()
+  {
+    EXPECT_EQ(centroids, expectedCentroids);
+    EXPECT_EQ(labels, expectedLabels);
+    std::fill(labels.begin(), labels.end(), 99u);
+  };
+  EXPECT_TRUE(kmeans.Cluster(obs.data(), obs.size(), 8, centroids,
+      labels.data()));
+  check();
+  EXPECT_TRUE(kmeans.Cluster(obsf.data(), obsf.size(), 8, centroids,
+      labels.data()));
+  check();
+  EXPECT_TRUE(kmeans.Cluster(x.data(), y.data(), z.data(), x.size(), 8,
+      centroids, labels.data()));
+  check();
+  EXPECT_TRUE(kmeans.Cluster(xf.data(), yf.data(), zf.data(), xf.size(), 8,
+      centroids, labels.data()));
+  check();
+
+  // Invalid input
+  EXPECT_FALSE(kmeans.Cluster(static_cast<const math::Vector3d *>(nullptr),
+      10, 2, centroids, labels.data()));
+  EXPECT_FALSE(kmeans.Cluster(obs.data(), obs.size(), 2, centroids,
+      nullptr));
+  EXPECT_FALSE(kmeans.Cluster(x.data(), nullptr, z.data(), x.size(), 2,
+      centroids, labels.data()));
+  EXPECT_FALSE(kmeans.Cluster(obsf.data(), 0, 1, centroids, labels.data()));
+  EXPECT_FALSE(kmeans.Cluster(xf.data(), yf.data(), zf.data(), 3, 4,
+      centroids, labels.data()));
+  EXPECT_FALSE(kmeans.Cluster(obs.data(), obs.size(), 0, centroids,
+      labels.data()));
+
+  // The default constructor has no observations
+  EXPECT_TRUE(kmeans.Observations().empty());
+  EXPECT_FALSE(kmeans.Cluster(1, centroids, labels));
+}
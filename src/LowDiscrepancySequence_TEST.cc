@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/LowDiscrepancySequence.hh"
+#include "ignition/math/RandomGenerator.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(LowDiscrepancySequenceTest, Sobol)
+{
+  math::SobolSequence sobol(2);
+  EXPECT_EQ(sobol.Dimensions(), 2u);
+  EXPECT_FALSE(sobol.Scrambled());
+  EXPECT_EQ(sobol.Index(), 0u);
+
+  std::vector<double> points(8);
+  EXPECT_TRUE(sobol.Fill(points));
+  EXPECT_EQ(sobol.Index(), 4u);
+  const std::vector<double> expected = {
+    0.0, 0.0, 0.5, 0.5, 0.75, 0.25, 0.25, 0.75};
+  EXPECT_EQ(points, expected);
+
+  // Size must be a multiple of the dimensions
+  std::vector<double> odd(3);
+  EXPECT_FALSE(sobol.Fill(odd));
+  EXPECT_EQ(sobol.Index(), 4u);
+
+  // Dimensions are clamped
+  EXPECT_EQ(math::SobolSequence(0).Dimensions(), 1u);
+  EXPECT_EQ(math::SobolSequence(9).Dimensions(), 6u);
+  EXPECT_DOUBLE_EQ(sobol.Sample(1, 2), 0.0);
+}
+
+//////////////////////////////////////////////////
+TEST(LowDiscrepancySequenceTest, SobolSkip)
+{
+  for (const bool scrambled : {false, true})
+  {
+    math::SobolSequence a = scrambled ? math::SobolSequence(6, 99) :
+      math::SobolSequence(6);
+    math::SobolSequence b = a;
+
+    std::vector<double> all(6 * 1000);
+    EXPECT_TRUE(a.Fill(all));
+
+    // Skipping gives the same points as generating them
+    b.Skip(700);
+    std::vector<double> tail(6 * 300);
+    EXPECT_TRUE(b.Fill(tail));
+    for (size_t i = 0; i < tail.size(); ++i)
+      EXPECT_DOUBLE_EQ(tail[i], all[6 * 700 + i]);
+
+    // Direct evaluation matches too
+    for (uint32_t i = 0; i < 1000; i += 37)
+    {
+      for (unsigned int d = 0; d < 6; ++d)
+        EXPECT_DOUBLE_EQ(a.Sample(i, d), all[6 * i + d]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(LowDiscrepancySequenceTest, SobolStratification)
+{
+  // The first 2^k points have one point in each of the 2^k intervals of
+  // each dimension, with and without scrambling.
+  for (const bool scrambled : {false, true})
+  {
+    math::SobolSequence sobol = scrambled ? math::SobolSequence(6, 5) :
+      math::SobolSequence(6);
+    EXPECT_EQ(sobol.Scrambled(), scrambled);
+    std::vector<double> points(6 * 256);
+    EXPECT_TRUE(sobol.Fill(points));
+    for (unsigned int d = 0; d < 6; ++d)
+    {
+      std::vector<int> counts(256, 0);
+      for (size_t i = 0; i < 256; ++i)
+      {
+        const double x = points[6 * i + d];
+        ASSERT_GE(x, 0.0);
+        ASSERT_LT(x, 1.0);
+        ++counts[static_cast<size_t>(x * 256)];
+      }
+      for (int count : counts)
+        EXPECT_EQ(count, 1);
+    }
+  }
+
+  // Different seeds give different points
+  math::SobolSequence a(2, 1);
+  math::SobolSequence b(2, 2);
+  EXPECT_NE(a.Sample(3, 0), b.Sample(3, 0));
+}
+
+//////////////////////////////////////////////////
+TEST(LowDiscrepancySequenceTest, Halton)
+{
+  math::HaltonSequence halton(2);
+  EXPECT_EQ(halton.Dimensions(), 2u);
+  std::vector<double> points(8);
+  EXPECT_TRUE(halton.Fill(points));
+  EXPECT_EQ(halton.Index(), 4u);
+  const double expected[] = {
+    0.0, 0.0, 0.5, 1.0 / 3, 0.25, 2.0 / 3, 0.75, 1.0 / 9};
+  for (size_t i = 0; i < points.size(); ++i)
+    EXPECT_DOUBLE_EQ(points[i], expected[i]);
+
+  std::vector<double> odd(3);
+  EXPECT_FALSE(halton.Fill(odd));
+
+  math::HaltonSequence six(6);
+  six.Skip(12);
+  std::vector<double> point(6);
+  EXPECT_TRUE(six.Fill(point));
+  EXPECT_DOUBLE_EQ(point[0], 0.1875);
+  EXPECT_DOUBLE_EQ(point[5], 12.0 / 13);
+  six.SetIndex(12);
+  EXPECT_EQ(six.Index(), 12u);
+  EXPECT_DOUBLE_EQ(six.Sample(13, 4), 2.0 / 11 + 1.0 / 121);
+  EXPECT_EQ(math::HaltonSequence(7).Dimensions(), 6u);
+}
+
+//////////////////////////////////////////////////
+TEST(LowDiscrepancySequenceTest, Integration)
+{
+  // Integral of x * y * z over the unit cube is 1/8. Low-discrepancy
+  // points are far more accurate than random points.
+  const size_t count = 4096;
+  std::vector<double> sobolPoints(3 * count);
+  std::vector<double> haltonPoints(3 * count);
+  std::vector<double> randomPoints(3 * count);
+  math::SobolSequence(3, 17).Fill(sobolPoints);
+  math::HaltonSequence(3).Fill(haltonPoints);
+  math::RandomGenerator(17).FillUniform(randomPoints);
+
+  auto integrate = [&](const std::vector<double> &_points)
+  {
+    double sum = 0;
+    for (size_t i = 0; i < _points.size(); i += 3)
+      sum += _points[i] * _points[i + 1] * _points[i + 2];
+    return std::abs(sum / count - 0.125);
+  };
+
+  EXPECT_LT(integrate(sobolPoints), 2e-4);
+  EXPECT_LT(integrate(haltonPoints), 1e-3);
+  EXPECT_GT(integrate(randomPoints), integrate(sobolPoints));
+}
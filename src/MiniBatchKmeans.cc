@@ -0,0 +1,274 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+#include "ignition/math/Kmeans.hh"
+#include "ignition/math/MiniBatchKmeans.hh"
+#include "ignition/math/RandomGenerator.hh"
+
+using namespace ignition;
+using namespace math;
+
+/// \brief Private data for the MiniBatchKmeans class.
+class ignition::math::MiniBatchKmeansPrivate
+{
+  /// \brief Constructor.
+  /// \param[in] _k Number of clusters.
+  /// \param[in] _seed Seed.
+  public: MiniBatchKmeansPrivate(unsigned int _k, unsigned int _seed)
+    : k(std::max(_k, 1u)), seed(_seed), generator(_seed)
+  {
+  }
+
+  /// \brief Get the closest centroid to a point.
+  /// \param[in] _p Point.
+  /// \return Index of the closest centroid.
+  public: unsigned int Nearest(const Vector3d &_p) const
+  {
+    double min = HUGE_VAL;
+    unsigned int minIdx = 0;
+    for (auto i = 0u; i < this->centroids.size(); ++i)
+    {
+      const double d = (_p - this->centroids[i]).SquaredLength();
+      if (d < min)
+      {
+        min = d;
+        minIdx = i;
+      }
+    }
+    return minIdx;
+  }
+
+  /// \brief Initialize the centroids by running Kmeans on observations.
+  /// \param[in] _obs At least k observations.
+  public: void Initialize(const std::vector<Vector3d> &_obs)
+  {
+    Kmeans kmeans;
+    kmeans.Seed(this->seed);
+    this->labels.resize(_obs.size());
+    kmeans.Cluster(_obs.data(), _obs.size(), static_cast<int>(this->k),
+        this->centroids, this->labels.data());
+
+    this->counts.assign(this->k, 0);
+    for (unsigned int label : this->labels)
+      ++this->counts[label];
+  }
+
+  /// \brief Move the centroids towards a batch of observations.
+  /// \param[in] _batch Observations.
+  public: void Step(const std::vector<Vector3d> &_batch)
+  {
+    // Assign the whole batch to the centroids of the start of the batch,
+    // then move each centroid to the running mean of its observations.
+    this->labels.resize(_batch.size());
+    for (size_t i = 0; i < _batch.size(); ++i)
+      this->labels[i] = this->Nearest(_batch[i]);
+
+    for (size_t i = 0; i < _batch.size(); ++i)
+    {
+      const unsigned int label = this->labels[i];
+      const double rate = 1.0 / static_cast<double>(++this->counts[label]);
+      this->centroids[label] += (_batch[i] - this->centroids[label]) * rate;
+    }
+  }
+
+  /// \brief Number of clusters.
+  public: unsigned int k;
+
+  /// \brief Seed of Kmeans and of the generator.
+  public: unsigned int seed;
+
+  /// \brief Generator of the batches of Fit.
+  public: RandomGenerator generator;
+
+  /// \brief Centroids, empty until initialized.
+  public: std::vector<Vector3d> centroids;
+
+  /// \brief Number of observations absorbed by each centroid.
+  public: std::vector<uint64_t> counts;
+
+  /// \brief Observations kept until there are enough to initialize.
+  public: std::vector<Vector3d> pending;
+
+  /// \brief Labels of the current batch.
+  public: std::vector<unsigned int> labels;
+
+  /// \brief Observations of the current batch of Fit.
+  public: std::vector<Vector3d> batch;
+};
+
+//////////////////////////////////////////////////
+MiniBatchKmeans::MiniBatchKmeans(unsigned int _k, unsigned int _seed)
+  : dataPtr(new MiniBatchKmeansPrivate(_k, _seed))
+{
+}
+
+//////////////////////////////////////////////////
+MiniBatchKmeans::~MiniBatchKmeans()
+{
+}
+
+//////////////////////////////////////////////////
+unsigned int MiniBatchKmeans::K() const
+{
+  return this->dataPtr->k;
+}
+
+//////////////////////////////////////////////////
+bool MiniBatchKmeans::Initialized() const
+{
+  return !this->dataPtr->centroids.empty();
+}
+
+//////////////////////////////////////////////////
+const std::vector<Vector3d> &MiniBatchKmeans::Centroids() const
+{
+  return this->dataPtr->centroids;
+}
+
+//////////////////////////////////////////////////
+const std::vector<uint64_t> &MiniBatchKmeans::Counts() const
+{
+  return this->dataPtr->counts;
+}
+
+//////////////////////////////////////////////////
+bool MiniBatchKmeans::Centroids(const std::vector<Vector3d> &_centroids)
+{
+  return this->Centroids(_centroids,
+      std::vector<uint64_t>(_centroids.size(), 1));
+}
+
+//////////////////////////////////////////////////
+bool MiniBatchKmeans::Centroids(const std::vector<Vector3d> &_centroids,
+    const std::vector<uint64_t> &_counts)
+{
+  if (_centroids.size() != this->dataPtr->k ||
+      _counts.size() != this->dataPtr->k)
+  {
+    std::cerr << "MiniBatchKmeans::Centroids() error: expected ["
+              << this->dataPtr->k << "] centroids and counts but got ["
+              << _centroids.size() << "] and [" << _counts.size() << "]"
+              << std::endl;
+    return false;
+  }
+
+  this->dataPtr->centroids = _centroids;
+  this->dataPtr->counts = _counts;
+  for (uint64_t &count : this->dataPtr->counts)
+    count = std::max<uint64_t>(count, 1);
+  this->dataPtr->pending.clear();
+  this->dataPtr->pending.shrink_to_fit();
+  return true;
+}
+
+//////////////////////////////////////////////////
+void MiniBatchKmeans::Reset()
+{
+  this->dataPtr->centroids.clear();
+  this->dataPtr->counts.clear();
+  this->dataPtr->pending.clear();
+}
+
+//////////////////////////////////////////////////
+bool MiniBatchKmeans::Update(const std::vector<Vector3d> &_batch)
+{
+  auto &d = *this->dataPtr;
+  if (!this->Initialized())
+  {
+    d.pending.insert(d.pending.end(), _batch.begin(), _batch.end());
+    if (d.pending.size() < d.k)
+      return false;
+
+    d.Initialize(d.pending);
+    d.pending.clear();
+    d.pending.shrink_to_fit();
+    return true;
+  }
+
+  d.Step(_batch);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool MiniBatchKmeans::Fit(const std::vector<Vector3d> &_obs,
+    unsigned int _iterations, unsigned int _batchSize)
+{
+  auto &d = *this->dataPtr;
+  if (_obs.size() < d.k)
+  {
+    std::cerr << "MiniBatchKmeans::Fit() error: The number of clusters ["
+              << d.k << "] has to be lower or equal to the number of"
+              << " observations [" << _obs.size() << "]" << std::endl;
+    return false;
+  }
+
+  const size_t count = _obs.size();
+  auto pick = [&]()
+  {
+    return std::min(count - 1, static_cast<size_t>(
+          d.generator.DblUniform(0, static_cast<double>(count))));
+  };
+
+  if (!this->Initialized())
+  {
+    const size_t sampleSize = 3 * static_cast<size_t>(
+        std::max(d.k, _batchSize));
+    if (sampleSize >= count)
+    {
+      d.Initialize(_obs);
+    }
+    else
+    {
+      d.batch.resize(sampleSize);
+      for (Vector3d &p : d.batch)
+        p = _obs[pick()];
+      d.Initialize(d.batch);
+    }
+    d.pending.clear();
+  }
+
+  d.batch.resize(std::max(_batchSize, 1u));
+  for (unsigned int iteration = 0; iteration < _iterations; ++iteration)
+  {
+    for (Vector3d &p : d.batch)
+      p = _obs[pick()];
+    d.Step(d.batch);
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+unsigned int MiniBatchKmeans::Label(const Vector3d &_p) const
+{
+  return this->dataPtr->Nearest(_p);
+}
+
+//////////////////////////////////////////////////
+bool MiniBatchKmeans::Labels(const std::vector<Vector3d> &_points,
+    std::vector<unsigned int> &_labels) const
+{
+  if (!this->Initialized())
+    return false;
+
+  _labels.resize(_points.size());
+  for (size_t i = 0; i < _points.size(); ++i)
+    _labels[i] = this->dataPtr->Nearest(_points[i]);
+  return true;
+}
@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "ignition/math/MiniBatchKmeans.hh"
+#include "ignition/math/RandomGenerator.hh"
+
+using namespace ignition;
+
+/// \brief Points around three well separated centers.
+/// \param[in] _count Number of points.
+/// \param[in] _generator Generator of the points.
+/// \return Points.
+std::vector<math::Vector3d> Blobs(size_t _count,
+    math::RandomGenerator &_generator)
+{
+  const math::Vector3d centers[] = {
+    {0, 0, 0}, {10, 0, 0}, {0, 10, 5}};
+  std::vector<math::Vector3d> points(_count);
+  for (size_t i = 0; i < _count; ++i)
+  {
+    points[i] = centers[i % 3] + math::Vector3d(
+        _generator.DblNormal(0, 0.5),
+        _generator.DblNormal(0, 0.5),
+        _generator.DblNormal(0, 0.5));
+  }
+  return points;
+}
+
+/// \brief Get whether each center is close to one of the centroids.
+/// \param[in] _centroids Centroids.
+/// \return True if every center has a centroid within 0.2.
+bool FoundCenters(const std::vector<math::Vector3d> &_centroids)
+{
+  for (const math::Vector3d &center :
+      {math::Vector3d(0, 0, 0), math::Vector3d(10, 0, 0),
+       math::Vector3d(0, 10, 5)})
+  {
+    bool found = false;
+    for (const math::Vector3d &centroid : _centroids)
+      found = found || centroid.Distance(center) < 0.2;
+    if (!found)
+      return false;
+  }
+  return true;
+}
+
+//////////////////////////////////////////////////
+TEST(MiniBatchKmeansTest, Update)
+{
+  math::MiniBatchKmeans kmeans(3);
+  EXPECT_EQ(kmeans.K(), 3u);
+  EXPECT_FALSE(kmeans.Initialized());
+  EXPECT_TRUE(kmeans.Centroids().empty());
+  EXPECT_TRUE(kmeans.Counts().empty());
+
+  std::vector<unsigned int> labels;
+  EXPECT_FALSE(kmeans.Labels({math::Vector3d::Zero}, labels));
+
+  // Observations are kept until there are enough to initialize
+  math::RandomGenerator generator(1);
+  EXPECT_FALSE(kmeans.Update(Blobs(2, generator)));
+  EXPECT_FALSE(kmeans.Initialized());
+  EXPECT_TRUE(kmeans.Update(Blobs(30, generator)));
+  EXPECT_TRUE(kmeans.Initialized());
+  ASSERT_EQ(kmeans.Centroids().size(), 3u);
+
+  uint64_t total = 0;
+  for (uint64_t count : kmeans.Counts())
+    total += count;
+  EXPECT_EQ(total, 32u);
+
+  // Stream batches
+  for (int i = 0; i < 50; ++i)
+    EXPECT_TRUE(kmeans.Update(Blobs(100, generator)));
+  EXPECT_TRUE(FoundCenters(kmeans.Centroids()));
+
+  total = 0;
+  for (uint64_t count : kmeans.Counts())
+    total += count;
+  EXPECT_EQ(total, 5032u);
+
+  // Points of the same blob have the same label
+  const std::vector<math::Vector3d> points = Blobs(30, generator);
+  EXPECT_TRUE(kmeans.Labels(points, labels));
+  ASSERT_EQ(labels.size(), points.size());
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    EXPECT_EQ(labels[i], labels[i % 3]);
+    EXPECT_EQ(labels[i], kmeans.Label(points[i]));
+  }
+  EXPECT_NE(labels[0], labels[1]);
+  EXPECT_NE(labels[0], labels[2]);
+  EXPECT_NE(labels[1], labels[2]);
+
+  kmeans.Reset();
+  EXPECT_FALSE(kmeans.Initialized());
+  EXPECT_TRUE(kmeans.Counts().empty());
+
+  // Zero clusters is replaced by one
+  math::MiniBatchKmeans one(0);
+  EXPECT_EQ(one.K(), 1u);
+  EXPECT_TRUE(one.Update({math::Vector3d(1, 2, 3)}));
+  EXPECT_EQ(one.Centroids()[0], math::Vector3d(1, 2, 3));
+  EXPECT_TRUE(one.Update({math::Vector3d(3, 2, 1)}));
+  EXPECT_EQ(one.Centroids()[0], math::Vector3d(2, 2, 2));
+}
+
+//////////////////////////////////////////////////
+TEST(MiniBatchKmeansTest, WarmStart)
+{
+  math::MiniBatchKmeans kmeans(2);
+  EXPECT_FALSE(kmeans.Centroids({math::Vector3d::Zero}));
+  EXPECT_FALSE(kmeans.Centroids({math::Vector3d::Zero, math::Vector3d::One},
+      {1}));
+  EXPECT_FALSE(kmeans.Initialized());
+
+  EXPECT_TRUE(kmeans.Centroids({math::Vector3d::Zero,
+      math::Vector3d(10, 0, 0)}));
+  EXPECT_TRUE(kmeans.Initialized());
+  EXPECT_EQ(kmeans.Counts(), std::vector<uint64_t>({1, 1}));
+
+  // Each centroid is the running mean of its observations
+  EXPECT_TRUE(kmeans.Update({math::Vector3d(2, 0, 0), math::Vector3d(9, 0, 0),
+      math::Vector3d(1, 0, 0)}));
+  EXPECT_EQ(kmeans.Centroids()[0], math::Vector3d(1, 0, 0));
+  EXPECT_EQ(kmeans.Centroids()[1], math::Vector3d(9.5, 0, 0));
+  EXPECT_EQ(kmeans.Counts(), std::vector<uint64_t>({3, 2}));
+
+  // Larger counts make centroids move less, and zero is replaced by one
+  EXPECT_TRUE(kmeans.Centroids({math::Vector3d::Zero,
+      math::Vector3d(10, 0, 0)}, {9, 0}));
+  EXPECT_EQ(kmeans.Counts(), std::vector<uint64_t>({9, 1}));
+  EXPECT_TRUE(kmeans.Update({math::Vector3d(4, 0, 0),
+      math::Vector3d(6, 0, 0)}));
+  EXPECT_EQ(kmeans.Centroids()[0], math::Vector3d(0.4, 0, 0));
+  EXPECT_EQ(kmeans.Centroids()[1], math::Vector3d(8, 0, 0));
+}
+
+//////////////////////////////////////////////////
+TEST(MiniBatchKmeansTest, Fit)
+{
+  math::MiniBatchKmeans kmeans(3, 5);
+  EXPECT_FALSE(kmeans.Fit({math::Vector3d::Zero, math::Vector3d::One}, 10));
+  EXPECT_FALSE(kmeans.Initialized());
+
+  math::RandomGenerator generator(2);
+  const std::vector<math::Vector3d> points = Blobs(20000, generator);
+  EXPECT_TRUE(kmeans.Fit(points, 20, 256));
+  EXPECT_TRUE(FoundCenters(kmeans.Centroids()));
+
+  // The same seed gives the same centroids
+  math::MiniBatchKmeans other(3, 5);
+  EXPECT_TRUE(other.Fit(points, 20, 256));
+  EXPECT_EQ(kmeans.Centroids(), other.Centroids());
+  EXPECT_EQ(kmeans.Counts(), other.Counts());
+
+  // Fitting again continues from the current centroids
+  EXPECT_TRUE(kmeans.Fit(points, 5, 256));
+  EXPECT_TRUE(FoundCenters(kmeans.Centroids()));
+
+  // Fewer observations than the initial sample
+  math::MiniBatchKmeans small(3);
+  EXPECT_TRUE(small.Fit(Blobs(300, generator), 10, 64));
+  EXPECT_TRUE(FoundCenters(small.Centroids()));
+}
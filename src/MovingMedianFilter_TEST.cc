@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <vector>
+
+#include "ignition/math/MovingMedianFilter.hh"
+#include "ignition/math/Rand.hh"
+
+using namespace ignition;
+
+/// \brief Median of a window by sorting, for reference.
+double SortedMedian(const std::deque<double> &_window)
+{
+  std::vector<double> sorted(_window.begin(), _window.end());
+  std::sort(sorted.begin(), sorted.end());
+  const size_t n = sorted.size();
+  if (n % 2 == 1)
+    return sorted[n / 2];
+  return (sorted[n / 2 - 1] + sorted[n / 2]) / 2;
+}
+
+/////////////////////////////////////////////////
+TEST(MovingMedianFilterTest, Constructor)
+{
+  math::MovingMedianFilter<double> filter;
+  EXPECT_EQ(filter.WindowSize(), 5u);
+  EXPECT_FALSE(filter.WindowFilled());
+  EXPECT_EQ(filter.Count(), 0u);
+  EXPECT_DOUBLE_EQ(filter.Value(), 0.0);
+
+  math::MovingMedianFilter<double> zero(0);
+  EXPECT_EQ(zero.WindowSize(), 5u);
+
+  zero.SetWindowSize(0);
+  EXPECT_EQ(zero.WindowSize(), 5u);
+}
+
+/////////////////////////////////////////////////
+TEST(MovingMedianFilterTest, Outlier)
+{
+  math::MovingMedianFilter<double> filter(3);
+  filter.Update(1.0);
+  EXPECT_DOUBLE_EQ(filter.Value(), 1.0);
+  filter.Update(3.0);
+  EXPECT_DOUBLE_EQ(filter.Value(), 2.0);
+  filter.Update(100.0);
+  EXPECT_DOUBLE_EQ(filter.Value(), 3.0);
+  EXPECT_TRUE(filter.WindowFilled());
+  filter.Update(2.0);
+  EXPECT_DOUBLE_EQ(filter.Value(), 3.0);
+  filter.Update(2.5);
+  EXPECT_DOUBLE_EQ(filter.Value(), 2.5);
+  filter.Update(2.5);
+  EXPECT_DOUBLE_EQ(filter.Value(), 2.5);
+
+  filter.Clear();
+  EXPECT_EQ(filter.Count(), 0u);
+  EXPECT_EQ(filter.WindowSize(), 3u);
+  filter.Update(-4.0);
+  EXPECT_DOUBLE_EQ(filter.Value(), -4.0);
+
+  math::MovingMedianFilter<int> ints(4);
+  for (int i : {5, 1, 9, 7})
+    ints.Update(i);
+  EXPECT_EQ(ints.Value(), 6);
+}
+
+/////////////////////////////////////////////////
+TEST(MovingMedianFilterTest, MatchesSort)
+{
+  for (unsigned int size = 1; size <= 9; ++size)
+  {
+    math::MovingMedianFilter<double> filter(size);
+    std::deque<double> window;
+    for (int i = 0; i < 300; ++i)
+    {
+      // Round to get repeated values
+      const double value =
+        std::round(math::Rand::DblUniform(-20.0, 20.0));
+      filter.Update(value);
+      window.push_back(value);
+      if (window.size() > size)
+        window.pop_front();
+
+      EXPECT_EQ(filter.Count(), window.size());
+      ASSERT_DOUBLE_EQ(filter.Value(), SortedMedian(window))
+        << "size " << size << " sample " << i;
+    }
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(MovingMedianFilterTest, Batch)
+{
+  std::vector<double> in(200);
+  for (auto &value : in)
+    value = math::Rand::DblNormal(0.0, 1.0);
+
+  math::MovingMedianFilter<double> single(7);
+  math::MovingMedianFilter<double> batch(7);
+  std::vector<double> out;
+  batch.Update(in, out);
+  ASSERT_EQ(out.size(), in.size());
+  for (size_t i = 0; i < in.size(); ++i)
+  {
+    single.Update(in[i]);
+    EXPECT_DOUBLE_EQ(out[i], single.Value());
+  }
+
+  // In place, continuing from the current window
+  std::vector<double> data(in.begin(), in.begin() + 20);
+  batch.Update(data, data);
+  for (size_t i = 0; i < 20; ++i)
+  {
+    single.Update(in[i]);
+    EXPECT_DOUBLE_EQ(data[i], single.Value());
+  }
+}
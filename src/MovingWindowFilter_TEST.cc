@@ -69,6 +69,56 @@ TEST(MovingWindowFilterTest, FilterSomething)
   EXPECT_EQ(vectorMWF.Value(), vsum / 20.0);
 }
 
+/////////////////////////////////////////////////
+TEST(MovingWindowFilterTest, StaticMovingWindowFilter)
+{
+  math::StaticMovingWindowFilter<int, 8> filterInt;
+  EXPECT_EQ(filterInt.WindowSize(), 8u);
+  EXPECT_FALSE(filterInt.WindowFilled());
+
+  filterInt.SetWindowSize(4);
+  EXPECT_EQ(filterInt.WindowSize(), 4u);
+  filterInt.SetWindowSize(10);
+  EXPECT_EQ(filterInt.WindowSize(), 8u);
+  filterInt.SetWindowSize(0);
+  EXPECT_EQ(filterInt.WindowSize(), 1u);
+
+  // Same values as the dynamically sized filter
+  math::MovingWindowFilter<double> doubleMWF;
+  math::StaticMovingWindowFilter<double, 16> doubleSMWF;
+  math::MovingWindowFilter<ignition::math::Vector3d> vectorMWF;
+  math::StaticMovingWindowFilter<ignition::math::Vector3d, 3> vectorSMWF;
+  doubleMWF.SetWindowSize(10);
+  doubleSMWF.SetWindowSize(10);
+  vectorMWF.SetWindowSize(3);
+
+  for (unsigned int i = 0; i < 25; ++i)
+  {
+    doubleMWF.Update(static_cast<double>(i * i));
+    doubleSMWF.Update(static_cast<double>(i * i));
+    ignition::math::Vector3d v(1.0*static_cast<double>(i),
+        -2.0*static_cast<double>(i),
+        3.0*static_cast<double>(i % 4));
+    vectorMWF.Update(v);
+    vectorSMWF.Update(v);
+
+    EXPECT_DOUBLE_EQ(doubleMWF.Value(), doubleSMWF.Value());
+    EXPECT_EQ(doubleMWF.WindowFilled(), doubleSMWF.WindowFilled());
+    EXPECT_EQ(vectorMWF.Value(), vectorSMWF.Value());
+    EXPECT_EQ(vectorMWF.WindowFilled(), vectorSMWF.WindowFilled());
+  }
+  EXPECT_TRUE(doubleSMWF.WindowFilled());
+
+  // SetWindowSize clears the history
+  doubleSMWF.SetWindowSize(2);
+  EXPECT_FALSE(doubleSMWF.WindowFilled());
+  doubleSMWF.Update(1.0);
+  doubleSMWF.Update(2.0);
+  doubleSMWF.Update(4.0);
+  EXPECT_TRUE(doubleSMWF.WindowFilled());
+  EXPECT_DOUBLE_EQ(doubleSMWF.Value(), 3.0);
+}
+
 int main(int argc, char **argv)
 {
   ::testing::InitGoogleTest(&argc, argv);
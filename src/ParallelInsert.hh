@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_PARALLELINSERT_HH_
+#define IGNITION_MATH_PARALLELINSERT_HH_
+
+#include <algorithm>
+#include <cstddef>
+#include <thread>
+#include <vector>
+#include <ignition/math/config.hh>
+#include "ChunkPool.hh"
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /// \internal
+    /// \brief Insert samples into statistics using several threads, for
+    /// SignalStats::InsertDataParallel and Vector3Stats::InsertDataParallel.
+    /// The samples are split in contiguous ranges that are inserted into
+    /// separate statistics and merged into _stats in order, so the result
+    /// does not depend on thread scheduling.
+    /// \param[in, out] _stats Statistics to insert into.
+    /// \param[in] _data Array of _count samples.
+    /// \param[in] _count Number of samples.
+    /// \param[in] _threadCount Number of threads to use. A value of zero
+    /// uses std::thread::hardware_concurrency().
+    /// \param[in] _initialize Function that adds the statistics of _stats to
+    /// an empty Stats.
+    /// \param[in] _insert Function that inserts a pointer and count of
+    /// samples into a Stats.
+    /// \return True if the samples were inserted, false if a statistic
+    /// does not support merging. In that case the samples are inserted
+    /// serially.
+    template<typename Stats, typename Sample, typename Initialize,
+             typename Insert>
+    bool ParallelInsert(Stats &_stats, const Sample *_data,
+        const size_t _count, unsigned int _threadCount,
+        Initialize _initialize, Insert _insert)
+    {
+      // Check that all statistics can be merged before doing any work
+      {
+        Stats probe;
+        Stats probe2;
+        _initialize(probe);
+        _initialize(probe2);
+        if (!probe.Merge(probe2))
+        {
+          _insert(_stats, _data, _count);
+          return false;
+        }
+      }
+
+      if (_threadCount == 0)
+        _threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+      // Starting a thread costs more than processing a few thousand samples
+      const size_t kMinSamplesPerThread = 4096;
+      const size_t threadCount = std::min<size_t>(_threadCount,
+          std::max<size_t>(1u, _count / kMinSamplesPerThread));
+      if (threadCount == 1)
+      {
+        _insert(_stats, _data, _count);
+        return true;
+      }
+
+      std::vector<Stats> partials(threadCount);
+      for (auto &partial : partials)
+        _initialize(partial);
+
+      const size_t rangeSize = (_count + threadCount - 1) / threadCount;
+      ChunkPool pool(static_cast<unsigned int>(threadCount));
+      pool.Run(threadCount, [&](const size_t _range)
+      {
+        const size_t begin = std::min(_count, _range * rangeSize);
+        const size_t end = std::min(_count, begin + rangeSize);
+
+        // Insert the range in blocks that stay in cache between the passes
+        // of each statistic
+        const size_t kBlockSize = 4096;
+        for (size_t start = begin; start < end; start += kBlockSize)
+        {
+          _insert(partials[_range], _data + start,
+              std::min(end - start, kBlockSize));
+        }
+      });
+
+      // Merge in order so the result is independent of scheduling
+      for (auto const &partial : partials)
+        _stats.Merge(partial);
+      return true;
+    }
+    }
+  }
+}
+#endif
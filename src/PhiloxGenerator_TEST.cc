@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "ignition/math/PhiloxGenerator.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(PhiloxGeneratorTest, KnownAnswers)
+{
+  // Known answer vectors of the Random123 library
+  auto block = math::PhiloxGenerator::Block(0, 0, 0);
+  EXPECT_EQ(block[0], 0x6627e8d5u);
+  EXPECT_EQ(block[1], 0xe169c58du);
+  EXPECT_EQ(block[2], 0xbc57ac4cu);
+  EXPECT_EQ(block[3], 0x9b00dbd8u);
+
+  block = math::PhiloxGenerator::Block(~0ull, ~0ull, ~0ull);
+  EXPECT_EQ(block[0], 0x408f276du);
+  EXPECT_EQ(block[1], 0x41c83b0eu);
+  EXPECT_EQ(block[2], 0xa20bc7c6u);
+  EXPECT_EQ(block[3], 0x6d5451fdu);
+
+  block = math::PhiloxGenerator::Block(0x299f31d0a4093822ull,
+      0x0370734413198a2eull, 0x85a308d3243f6a88ull);
+  EXPECT_EQ(block[0], 0xd16cfe09u);
+  EXPECT_EQ(block[1], 0x94fdccebu);
+  EXPECT_EQ(block[2], 0x5001e420u);
+  EXPECT_EQ(block[3], 0x24126ea1u);
+}
+
+//////////////////////////////////////////////////
+TEST(PhiloxGeneratorTest, Counter)
+{
+  math::PhiloxGenerator a(42, 3);
+  EXPECT_EQ(a.Seed(), 42u);
+  EXPECT_EQ(a.Stream(), 3u);
+  EXPECT_EQ(a.Counter(), 0u);
+
+  std::vector<double> values;
+  for (int i = 0; i < 10; ++i)
+    values.push_back(a.DblNormal());
+  EXPECT_EQ(a.Counter(), 10u);
+
+  // Any value can be computed directly from its counter
+  math::PhiloxGenerator b(42, 3, 7);
+  EXPECT_DOUBLE_EQ(b.DblNormal(), values[7]);
+  b.SetCounter(2);
+  EXPECT_DOUBLE_EQ(b.DblNormal(), values[2]);
+
+  // Other streams and seeds give other values
+  math::PhiloxGenerator c(42, 4);
+  math::PhiloxGenerator d(43, 3);
+  EXPECT_NE(c.DblNormal(), values[0]);
+  EXPECT_NE(d.DblNormal(), values[0]);
+
+  // Fills can be split at block boundaries
+  std::vector<double> whole(10);
+  math::PhiloxGenerator e(1, 2);
+  e.FillNormal(whole);
+  EXPECT_EQ(e.Counter(), 5u);
+
+  std::vector<double> first(4);
+  std::vector<double> second(6);
+  math::PhiloxGenerator f(1, 2);
+  math::PhiloxGenerator g(1, 2, 2);
+  f.FillNormal(first);
+  g.FillNormal(second);
+  for (size_t i = 0; i < first.size(); ++i)
+    EXPECT_DOUBLE_EQ(first[i], whole[i]);
+  for (size_t i = 0; i < second.size(); ++i)
+    EXPECT_DOUBLE_EQ(second[i], whole[i + 4]);
+
+  // An odd size uses a whole block
+  std::vector<float> floats(5);
+  f.FillUniform(floats);
+  EXPECT_EQ(f.Counter(), 4u);
+}
+
+//////////////////////////////////////////////////
+TEST(PhiloxGeneratorTest, Distributions)
+{
+  math::PhiloxGenerator generator(7);
+
+  std::vector<double> uniform(200001);
+  generator.FillUniform(uniform, -2.0, 6.0);
+  double sum = 0;
+  for (double value : uniform)
+  {
+    EXPECT_GE(value, -2.0);
+    EXPECT_LT(value, 6.0);
+    sum += value;
+  }
+  EXPECT_NEAR(sum / uniform.size(), 2.0, 0.05);
+
+  std::vector<float> floats(100003);
+  generator.FillUniform(floats, 1.0f, 2.0f);
+  double floatSum = 0;
+  for (float value : floats)
+  {
+    EXPECT_GE(value, 1.0f);
+    EXPECT_LE(value, 2.0f);
+    floatSum += value;
+  }
+  EXPECT_NEAR(floatSum / floats.size(), 1.5, 0.01);
+
+  std::vector<double> normal(1000000);
+  generator.FillNormal(normal, 1.0, 2.0);
+  sum = 0;
+  double sumSquares = 0;
+  size_t beyond1Sigma = 0;
+  for (double value : normal)
+  {
+    sum += value;
+    sumSquares += value * value;
+    beyond1Sigma += std::abs(value - 1.0) > 2.0;
+  }
+  const double n = static_cast<double>(normal.size());
+  const double mean = sum / n;
+  EXPECT_NEAR(mean, 1.0, 0.01);
+  EXPECT_NEAR(sumSquares / n - mean * mean, 4.0, 0.03);
+  EXPECT_NEAR(beyond1Sigma / n, 0.3173, 0.003);
+
+  std::vector<float> normalFloats(100000);
+  generator.FillNormal(normalFloats, -1.0f, 0.5f);
+  floatSum = 0;
+  for (float value : normalFloats)
+    floatSum += value;
+  EXPECT_NEAR(floatSum / normalFloats.size(), -1.0, 0.01);
+
+  int counts[6] = {0, 0, 0, 0, 0, 0};
+  for (int i = 0; i < 60000; ++i)
+  {
+    const int value = generator.IntUniform(1, 6);
+    ASSERT_GE(value, 1);
+    ASSERT_LE(value, 6);
+    ++counts[value - 1];
+  }
+  for (int count : counts)
+    EXPECT_NEAR(count, 10000, 400);
+
+  EXPECT_EQ(generator.IntUniform(3, 3), 3);
+  EXPECT_EQ(generator.IntUniform(5, 1), 5);
+  const int32_t full = generator.IntUniform(INT32_MIN, INT32_MAX);
+  EXPECT_GE(full, INT32_MIN);
+
+  const double value = generator.DblUniform(10, 20);
+  EXPECT_GE(value, 10);
+  EXPECT_LT(value, 20);
+}
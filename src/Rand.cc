@@ -17,6 +17,7 @@
 
 #include <sys/types.h>
 #include <ctime>
+#include <optional>
 
 #ifdef _WIN32
   #include <process.h>
@@ -26,16 +27,76 @@
 #endif
 
 #include "ignition/math/Rand.hh"
+#include "ignition/math/RandomGenerator.hh"
 
 using namespace ignition;
 using namespace math;
 
+namespace
+{
+  /// \brief Number of calls to Rand::Seed. Thread generators that were
+  /// seeded before the last call are reseeded when they are next used.
+  std::atomic<uint64_t> seedEpoch{0};
+
+  /// \brief Next stream index for a thread generator. Stream 0 is
+  /// reserved for the thread that calls Rand::Seed.
+  std::atomic<uint64_t> nextStream{1};
+
+  /// \brief Random generator of one thread.
+  struct ThreadGenerator
+  {
+    /// \brief Seed the generator, constructing it the first time.
+    /// \param[in] _seed Seed.
+    /// \param[in] _stream Stream index.
+    /// \param[in] _epoch Value of seedEpoch for this seed.
+    void Seed(unsigned int _seed, uint64_t _stream, uint64_t _epoch)
+    {
+      if (this->generator)
+        this->generator->Seed(_seed, _stream);
+      else
+        this->generator.emplace(_seed, _stream);
+      this->epoch = _epoch;
+    }
+
+    /// \brief Generator, constructed with its seed on first use.
+    std::optional<RandomGenerator> generator;
+
+    /// \brief Value of seedEpoch when the generator was last seeded.
+    uint64_t epoch = 0;
+
+    /// \brief Stream used when another thread called Rand::Seed.
+    uint64_t stream = nextStream++;
+  };
+
+  /// \brief Get the generator of the calling thread.
+  /// \return Thread generator.
+  ThreadGenerator &ThisThreadGenerator()
+  {
+    thread_local ThreadGenerator generator;
+    return generator;
+  }
+
+  /// \brief Get the generator of the calling thread, reseeding it if
+  /// Rand::Seed was called since it was last used.
+  /// \param[in] _seed Global seed. It is read after the number of calls
+  /// to Rand::Seed, which is incremented after the seed is set.
+  /// \return Random generator.
+  RandomGenerator &ThisThreadRandomGenerator(
+      const std::atomic<uint32_t> &_seed)
+  {
+    ThreadGenerator &thread = ThisThreadGenerator();
+    const uint64_t epoch = seedEpoch;
+    if (!thread.generator || thread.epoch != epoch)
+      thread.Seed(_seed.load(), thread.stream, epoch);
+    return *thread.generator;
+  }
+}
+
 //////////////////////////////////////////////////
 void Rand::Seed(unsigned int _seed)
 {
-  std::seed_seq seq{_seed};
   SeedMutable() = _seed;
-  RandGenerator().seed(seq);
+  ThisThreadGenerator().Seed(_seed, 0, ++seedEpoch);
 }
 
 //////////////////////////////////////////////////
@@ -75,18 +136,43 @@ int32_t Rand::IntNormal(int _mean, int _sigma)
 }
 
 //////////////////////////////////////////////////
-uint32_t &Rand::SeedMutable()
+void Rand::FillUniform(std::vector<double> &_values, double _min,
+    double _max)
+{
+  ThisThreadRandomGenerator(SeedMutable()).FillUniform(_values, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillUniform(std::vector<float> &_values, float _min, float _max)
+{
+  ThisThreadRandomGenerator(SeedMutable()).FillUniform(_values, _min, _max);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillNormal(std::vector<double> &_values, double _mean,
+    double _sigma)
+{
+  ThisThreadRandomGenerator(SeedMutable()).FillNormal(_values, _mean, _sigma);
+}
+
+//////////////////////////////////////////////////
+void Rand::FillNormal(std::vector<float> &_values, float _mean, float _sigma)
+{
+  ThisThreadRandomGenerator(SeedMutable()).FillNormal(_values, _mean, _sigma);
+}
+
+//////////////////////////////////////////////////
+std::atomic<uint32_t> &Rand::SeedMutable()
 {
   // We don't seed with time for the cases when two processes are started the
   // same time (this mostly happens with launch scripts that start a server
   // and gui simultaneously).
-  static uint32_t seed = std::random_device {}();
+  static std::atomic<uint32_t> seed{std::random_device {}()};
   return seed;
 }
 
 //////////////////////////////////////////////////
 GeneratorType &Rand::RandGenerator()
 {
-  static GeneratorType randGenerator(Seed());
-  return randGenerator;
+  return ThisThreadRandomGenerator(SeedMutable()).Generator();
 }
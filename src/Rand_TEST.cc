@@ -17,8 +17,12 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 #include "ignition/math/Helpers.hh"
 #include "ignition/math/Rand.hh"
+#include "ignition/math/RandomGenerator.hh"
 
 using namespace ignition;
 
@@ -77,3 +81,35 @@ TEST(RandTest, SetSeed)
     EXPECT_EQ(second[i], math::Rand::IntUniform(-10, 10));
   }
 }
+
+//////////////////////////////////////////////////
+TEST(RandTest, Threads)
+{
+  math::Rand::Seed(123);
+  const double expected = math::RandomGenerator(123).DblUniform();
+
+  // Each thread has its own generator, seeded with its own stream.
+  const int threadCount = 4;
+  std::vector<std::vector<double>> values(threadCount);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < threadCount; ++t)
+  {
+    threads.emplace_back([&values, t]()
+    {
+      for (int i = 0; i < 1000; ++i)
+        values[t].push_back(math::Rand::DblUniform());
+      EXPECT_EQ(math::Rand::Seed(), 123u);
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (int t = 0; t < threadCount; ++t)
+  {
+    for (int u = t + 1; u < threadCount; ++u)
+      EXPECT_NE(values[t], values[u]);
+  }
+
+  // This thread was not affected by the other threads.
+  EXPECT_DOUBLE_EQ(math::Rand::DblUniform(), expected);
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include "ignition/math/RandomGenerator.hh"
+#include "RandomGeneratorPrivate.hh"
+
+using namespace ignition;
+using namespace math;
+
+//////////////////////////////////////////////////
+RandomGenerator::RandomGenerator()
+  : RandomGenerator(std::random_device {}())
+{
+}
+
+//////////////////////////////////////////////////
+RandomGenerator::RandomGenerator(unsigned int _seed, uint64_t _stream)
+  : dataPtr(new RandomGeneratorPrivate)
+{
+  this->Seed(_seed, _stream);
+}
+
+//////////////////////////////////////////////////
+RandomGenerator::RandomGenerator(const RandomGenerator &_other)
+  : dataPtr(new RandomGeneratorPrivate(*_other.dataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+RandomGenerator::~RandomGenerator()
+{
+}
+
+//////////////////////////////////////////////////
+RandomGenerator &RandomGenerator::operator=(const RandomGenerator &_other)
+{
+  *this->dataPtr = *_other.dataPtr;
+  return *this;
+}
+
+//////////////////////////////////////////////////
+void RandomGenerator::Seed(unsigned int _seed, uint64_t _stream)
+{
+  this->dataPtr->seed = _seed;
+  this->dataPtr->stream = _stream;
+
+  // Stream 0 uses the same seed sequence as Rand::Seed.
+  if (_stream == 0)
+  {
+    std::seed_seq seq{_seed};
+    this->dataPtr->engine.seed(seq);
+    this->dataPtr->fastEngine.seed(seq);
+  }
+  else
+  {
+    std::seed_seq seq{_seed, static_cast<uint32_t>(_stream),
+      static_cast<uint32_t>(_stream >> 32)};
+    this->dataPtr->engine.seed(seq);
+    this->dataPtr->fastEngine.seed(seq);
+  }
+}
+
+//////////////////////////////////////////////////
+unsigned int RandomGenerator::Seed() const
+{
+  return this->dataPtr->seed;
+}
+
+//////////////////////////////////////////////////
+uint64_t RandomGenerator::Stream() const
+{
+  return this->dataPtr->stream;
+}
+
+//////////////////////////////////////////////////
+double RandomGenerator::DblUniform(double _min, double _max)
+{
+  UniformRealDist d(_min, _max);
+  return d(this->dataPtr->engine);
+}
+
+//////////////////////////////////////////////////
+double RandomGenerator::DblNormal(double _mean, double _sigma)
+{
+  NormalRealDist d(_mean, _sigma);
+  return d(this->dataPtr->engine);
+}
+
+//////////////////////////////////////////////////
+int32_t RandomGenerator::IntUniform(int _min, int _max)
+{
+  UniformIntDist d(_min, _max);
+  return d(this->dataPtr->engine);
+}
+
+//////////////////////////////////////////////////
+int32_t RandomGenerator::IntNormal(int _mean, int _sigma)
+{
+  NormalRealDist d(_mean, _sigma);
+  return static_cast<int32_t>(d(this->dataPtr->engine));
+}
+
+//////////////////////////////////////////////////
+void RandomGenerator::FillUniform(std::vector<double> &_values,
+    double _min, double _max)
+{
+  Xoshiro256PlusPlus engine = this->dataPtr->fastEngine;
+  const double range = _max - _min;
+  for (double &value : _values)
+    value = _min + range * UniformDouble(engine());
+  this->dataPtr->fastEngine = engine;
+}
+
+//////////////////////////////////////////////////
+void RandomGenerator::FillUniform(std::vector<float> &_values,
+    float _min, float _max)
+{
+  // Each 64 bit value gives two floats with 24 random bits each.
+  Xoshiro256PlusPlus engine = this->dataPtr->fastEngine;
+  const float range = _max - _min;
+  const size_t size = _values.size();
+  size_t i = 0;
+  for (; i + 1 < size; i += 2)
+  {
+    const uint64_t bits = engine();
+    _values[i] = _min + range *
+      (static_cast<float>(bits >> 40) * 0x1.0p-24f);
+    _values[i + 1] = _min + range *
+      (static_cast<float>((bits >> 8) & 0xffffff) * 0x1.0p-24f);
+  }
+  if (i < size)
+    _values[i] = _min + range * (static_cast<float>(engine() >> 40) *
+        0x1.0p-24f);
+  this->dataPtr->fastEngine = engine;
+}
+
+//////////////////////////////////////////////////
+void RandomGenerator::FillNormal(std::vector<double> &_values,
+    double _mean, double _sigma)
+{
+  const ZigguratTables &tables = ZigguratTables::Instance();
+  Xoshiro256PlusPlus engine = this->dataPtr->fastEngine;
+  for (double &value : _values)
+    value = _mean + _sigma * ZigguratNormal(engine, tables);
+  this->dataPtr->fastEngine = engine;
+}
+
+//////////////////////////////////////////////////
+void RandomGenerator::FillNormal(std::vector<float> &_values,
+    float _mean, float _sigma)
+{
+  const ZigguratTables &tables = ZigguratTables::Instance();
+  Xoshiro256PlusPlus engine = this->dataPtr->fastEngine;
+  for (float &value : _values)
+  {
+    value = _mean + _sigma *
+      static_cast<float>(ZigguratNormal(engine, tables));
+  }
+  this->dataPtr->fastEngine = engine;
+}
+
+//////////////////////////////////////////////////
+GeneratorType &RandomGenerator::Generator()
+{
+  return this->dataPtr->engine;
+}
@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#ifndef IGNITION_MATH_RANDOMGENERATORPRIVATE_HH_
+#define IGNITION_MATH_RANDOMGENERATORPRIVATE_HH_
+
+#include <cmath>
+#include <cstdint>
+#include <ignition/math/RandomGenerator.hh>
+#include <ignition/math/config.hh>
+
+namespace ignition
+{
+  namespace math
+  {
+    inline namespace IGNITION_MATH_VERSION_NAMESPACE
+    {
+    /// \brief Private data for the RandomGenerator class.
+    class RandomGeneratorPrivate
+    {
+      /// \brief Random engine.
+      public: GeneratorType engine;
+
+      /// \brief Engine of the Fill functions.
+      public: Xoshiro256PlusPlus fastEngine;
+
+      /// \brief Seed used to initialize the engine.
+      public: unsigned int seed = 0;
+
+      /// \brief Stream index used to initialize the engine.
+      public: uint64_t stream = 0;
+    };
+
+    /// \brief Convert the upper 53 bits of a random value to a double in
+    /// [0, 1).
+    /// \param[in] _bits Random bits.
+    /// \return Uniform double.
+    inline double UniformDouble(uint64_t _bits)
+    {
+      return static_cast<double>(_bits >> 11) * 0x1.0p-53;
+    }
+
+    /// \brief Convert the upper 53 bits of a random value to a double in
+    /// (0, 1), for use with logarithms.
+    /// \param[in] _bits Random bits.
+    /// \return Uniform double.
+    inline double UniformOpenDouble(uint64_t _bits)
+    {
+      return (static_cast<double>(_bits >> 11) + 0.5) * 0x1.0p-53;
+    }
+
+    /// \brief Tables of the Ziggurat method for the standard normal
+    /// distribution with 128 layers, from Doornik, "An Improved Ziggurat
+    /// Method to Generate Normal Random Samples", 2005.
+    class ZigguratTables
+    {
+      /// \brief Number of layers.
+      public: static constexpr int kLayers = 128;
+
+      /// \brief Start of the tail.
+      public: static constexpr double kTail = 3.442619855899;
+
+      /// \brief Area of each layer.
+      public: static constexpr double kArea = 9.91256303526217e-3;
+
+      /// \brief Get the tables, computed on first use.
+      /// \return Tables.
+      public: static const ZigguratTables &Instance()
+      {
+        static const ZigguratTables tables;
+        return tables;
+      }
+
+      /// \brief Compute the tables.
+      private: ZigguratTables()
+      {
+        double f = std::exp(-0.5 * kTail * kTail);
+        this->x[0] = kArea / f;
+        this->x[1] = kTail;
+        this->x[kLayers] = 0;
+        for (int i = 2; i < kLayers; ++i)
+        {
+          this->x[i] = std::sqrt(-2 * std::log(kArea / this->x[i - 1] + f));
+          f = std::exp(-0.5 * this->x[i] * this->x[i]);
+        }
+        for (int i = 0; i < kLayers; ++i)
+          this->ratio[i] = this->x[i + 1] / this->x[i];
+      }
+
+      /// \brief Right edge of each layer.
+      public: double x[kLayers + 1];
+
+      /// \brief Ratio of the right edges of the next and current layers.
+      public: double ratio[kLayers];
+    };
+
+    /// \brief Sample the standard normal distribution with the Ziggurat
+    /// method.
+    /// \param[in] _engine Engine that returns uniform 64 bit values.
+    /// \param[in] _tables Ziggurat tables.
+    /// \return Normal sample.
+    template<typename Engine>
+    double ZigguratNormal(Engine &_engine, const ZigguratTables &_tables)
+    {
+      while (true)
+      {
+        // The low 7 bits select the layer and the upper 53 bits give a
+        // uniform value in [-1, 1).
+        const uint64_t bits = _engine();
+        const int i = static_cast<int>(bits & (ZigguratTables::kLayers - 1));
+        const double u = 2.0 * UniformDouble(bits) - 1.0;
+
+        // Inside the rectangle of the layer, which is the common case
+        if (std::abs(u) < _tables.ratio[i])
+          return u * _tables.x[i];
+
+        // The bottom layer continues with the tail
+        if (i == 0)
+        {
+          double x;
+          double y;
+          do
+          {
+            x = std::log(UniformOpenDouble(_engine())) /
+              ZigguratTables::kTail;
+            y = std::log(UniformOpenDouble(_engine()));
+          }
+          while (-2 * y < x * x);
+          return u < 0 ? x - ZigguratTables::kTail :
+            ZigguratTables::kTail - x;
+        }
+
+        // In the wedge between the rectangle and the density
+        const double x = u * _tables.x[i];
+        const double f0 = std::exp(-0.5 * (_tables.x[i] * _tables.x[i] -
+            x * x));
+        const double f1 = std::exp(-0.5 * (_tables.x[i + 1] *
+            _tables.x[i + 1] - x * x));
+        if (f1 + UniformDouble(_engine()) * (f0 - f1) < 1.0)
+          return x;
+      }
+    }
+    }
+  }
+}
+#endif
@@ -0,0 +1,226 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/RandomGenerator.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(RandomGeneratorTest, Seed)
+{
+  math::RandomGenerator a(42);
+  math::RandomGenerator b(42);
+  EXPECT_EQ(a.Seed(), 42u);
+  EXPECT_EQ(a.Stream(), 0u);
+  for (int i = 0; i < 100; ++i)
+    EXPECT_DOUBLE_EQ(a.DblUniform(), b.DblUniform());
+
+  // Reseeding restarts the sequence
+  a.Seed(42);
+  b.Seed(42);
+  EXPECT_EQ(a.IntUniform(-100, 100), b.IntUniform(-100, 100));
+  EXPECT_DOUBLE_EQ(a.DblNormal(1, 2), b.DblNormal(1, 2));
+  EXPECT_EQ(a.IntNormal(10, 5), b.IntNormal(10, 5));
+
+  // Stream 0 matches Rand with the same seed
+  math::Rand::Seed(1001);
+  math::RandomGenerator c(1001);
+  EXPECT_DOUBLE_EQ(c.DblNormal(2, 3), math::Rand::DblNormal(2, 3));
+  EXPECT_EQ(c.IntNormal(10, 5), math::Rand::IntNormal(10, 5));
+
+  // The default constructor picks a seed
+  math::RandomGenerator d;
+  double value = d.DblUniform(1, 2);
+  EXPECT_GE(value, 1);
+  EXPECT_LE(value, 2);
+}
+
+//////////////////////////////////////////////////
+TEST(RandomGeneratorTest, Streams)
+{
+  math::RandomGenerator a(7, 0);
+  math::RandomGenerator b(7, 1);
+  math::RandomGenerator c(7, 1ull << 40);
+  EXPECT_EQ(b.Stream(), 1u);
+  EXPECT_EQ(c.Stream(), 1ull << 40);
+
+  int sameAB = 0;
+  int sameBC = 0;
+  for (int i = 0; i < 100; ++i)
+  {
+    const auto x = a.Generator()();
+    const auto y = b.Generator()();
+    const auto z = c.Generator()();
+    sameAB += x == y;
+    sameBC += y == z;
+  }
+  EXPECT_LT(sameAB, 3);
+  EXPECT_LT(sameBC, 3);
+
+  // Same seed and stream give the same values
+  math::RandomGenerator d(7, 1ull << 40);
+  math::RandomGenerator e(7, 1ull << 40);
+  EXPECT_EQ(d.Generator()(), e.Generator()());
+}
+
+//////////////////////////////////////////////////
+TEST(RandomGeneratorTest, Copy)
+{
+  math::RandomGenerator a(3, 5);
+  a.DblUniform();
+
+  math::RandomGenerator b(a);
+  EXPECT_EQ(b.Seed(), 3u);
+  EXPECT_EQ(b.Stream(), 5u);
+  for (int i = 0; i < 10; ++i)
+    EXPECT_DOUBLE_EQ(a.DblUniform(), b.DblUniform());
+
+  math::RandomGenerator c(9);
+  c = a;
+  EXPECT_EQ(c.Seed(), 3u);
+  EXPECT_DOUBLE_EQ(a.DblNormal(), c.DblNormal());
+}
+
+//////////////////////////////////////////////////
+TEST(RandomGeneratorTest, Xoshiro256PlusPlus)
+{
+  math::Xoshiro256PlusPlus a(5);
+  math::Xoshiro256PlusPlus b(5);
+  for (int i = 0; i < 10; ++i)
+    EXPECT_EQ(a(), b());
+
+  // Jumped engines produce other values
+  b.Jump();
+  int same = 0;
+  for (int i = 0; i < 100; ++i)
+    same += a() == b();
+  EXPECT_EQ(same, 0);
+
+  // Usable with standard distributions
+  std::uniform_int_distribution<int> dist(1, 6);
+  for (int i = 0; i < 100; ++i)
+  {
+    const int value = dist(a);
+    EXPECT_GE(value, 1);
+    EXPECT_LE(value, 6);
+  }
+
+  std::seed_seq seq{1, 2, 3};
+  a.seed(seq);
+  std::seed_seq seq2{1, 2, 3};
+  b.seed(seq2);
+  EXPECT_EQ(a(), b());
+}
+
+//////////////////////////////////////////////////
+TEST(RandomGeneratorTest, FillUniform)
+{
+  math::RandomGenerator generator(11);
+  std::vector<double> values(200000);
+  generator.FillUniform(values, -2.0, 6.0);
+  EXPECT_EQ(values.size(), 200000u);
+
+  double sum = 0;
+  for (double value : values)
+  {
+    EXPECT_GE(value, -2.0);
+    EXPECT_LT(value, 6.0);
+    sum += value;
+  }
+  EXPECT_NEAR(sum / values.size(), 2.0, 0.05);
+
+  std::vector<float> floats(100001);
+  generator.FillUniform(floats, 1.0f, 2.0f);
+  double floatSum = 0;
+  for (float value : floats)
+  {
+    EXPECT_GE(value, 1.0f);
+    EXPECT_LE(value, 2.0f);
+    floatSum += value;
+  }
+  EXPECT_NEAR(floatSum / floats.size(), 1.5, 0.01);
+
+  // Same seed and stream give the same values, regardless of the other
+  // functions.
+  math::RandomGenerator a(11, 3);
+  math::RandomGenerator b(11, 3);
+  b.DblUniform();
+  std::vector<double> first(10);
+  std::vector<double> second(10);
+  a.FillUniform(first);
+  b.FillUniform(second);
+  EXPECT_EQ(first, second);
+}
+
+//////////////////////////////////////////////////
+TEST(RandomGeneratorTest, FillNormal)
+{
+  math::RandomGenerator generator(21);
+  std::vector<double> values(1000000);
+  generator.FillNormal(values, 1.0, 2.0);
+
+  double sum = 0;
+  double sumSquares = 0;
+  size_t beyond3Sigma = 0;
+  size_t beyond1Sigma = 0;
+  for (double value : values)
+  {
+    sum += value;
+    sumSquares += value * value;
+    const double z = std::abs(value - 1.0) / 2.0;
+    beyond1Sigma += z > 1.0;
+    beyond3Sigma += z > 3.0;
+  }
+  const double n = static_cast<double>(values.size());
+  const double mean = sum / n;
+  EXPECT_NEAR(mean, 1.0, 0.01);
+  EXPECT_NEAR(sumSquares / n - mean * mean, 4.0, 0.03);
+  EXPECT_NEAR(beyond1Sigma / n, 0.3173, 0.003);
+  EXPECT_NEAR(beyond3Sigma / n, 0.0027, 0.0003);
+
+  std::vector<float> floats(100000);
+  generator.FillNormal(floats, -1.0f, 0.5f);
+  double floatSum = 0;
+  for (float value : floats)
+    floatSum += value;
+  EXPECT_NEAR(floatSum / floats.size(), -1.0, 0.01);
+
+  // The static API uses the thread generator
+  math::Rand::Seed(5);
+  std::vector<double> first(100);
+  math::Rand::FillNormal(first);
+  math::Rand::Seed(5);
+  std::vector<double> second(100);
+  math::Rand::FillNormal(second);
+  EXPECT_EQ(first, second);
+
+  std::vector<double> expected(100);
+  math::RandomGenerator(5).FillNormal(expected);
+  EXPECT_EQ(first, expected);
+
+  std::vector<float> uniform(10);
+  math::Rand::FillUniform(uniform, 3.0f, 4.0f);
+  for (float value : uniform)
+    EXPECT_GE(value, 3.0f);
+}
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "ignition/math/Rand.hh"
+#include "ignition/math/Resampler.hh"
+
+using namespace ignition;
+
+/// \brief Reference resampler: insert zeros, convolve, keep every
+/// _down-th sample.
+std::vector<double> Reference(const std::vector<double> &_in,
+    unsigned int _up, unsigned int _down, const std::vector<double> &_taps)
+{
+  std::vector<double> upsampled(_in.size() * _up, 0.0);
+  for (size_t i = 0; i < _in.size(); ++i)
+    upsampled[i * _up] = _in[i] * _up;
+
+  std::vector<double> out;
+  for (size_t t = 0; t < upsampled.size(); t += _down)
+  {
+    double y = 0.0;
+    for (size_t k = 0; k < _taps.size() && k <= t; ++k)
+      y += _taps[k] * upsampled[t - k];
+    out.push_back(y);
+  }
+  return out;
+}
+
+/////////////////////////////////////////////////
+TEST(ResamplerTest, FirLowPass)
+{
+  auto taps = math::FirLowPass(31, 100.0, 1000.0);
+  ASSERT_EQ(taps.size(), 31u);
+  EXPECT_NEAR(std::accumulate(taps.begin(), taps.end(), 0.0), 1.0, 1e-12);
+
+  // Symmetric, so linear phase
+  for (size_t i = 0; i < taps.size(); ++i)
+    EXPECT_NEAR(taps[i], taps[taps.size() - 1 - i], 1e-15);
+
+  // Strong attenuation well above the cutoff
+  double re = 0.0;
+  double im = 0.0;
+  for (size_t i = 0; i < taps.size(); ++i)
+  {
+    re += taps[i] * std::cos(2 * IGN_PI * 0.4 * i);
+    im += taps[i] * std::sin(2 * IGN_PI * 0.4 * i);
+  }
+  EXPECT_LT(std::hypot(re, im), 0.01);
+
+  EXPECT_EQ(math::FirLowPass(0, 1.0, 10.0).size(), 1u);
+  EXPECT_EQ(math::FirResamplingTaps(3, 2, 8).size(), 24u);
+}
+
+/////////////////////////////////////////////////
+TEST(ResamplerTest, Decimator)
+{
+  std::vector<double> in(400);
+  for (auto &value : in)
+    value = math::Rand::DblUniform(-1.0, 1.0);
+
+  const auto taps = math::FirLowPass(20, 0.1, 1.0);
+  math::FirDecimator<double> decimator(4, taps);
+  EXPECT_EQ(decimator.Factor(), 4u);
+  EXPECT_EQ(decimator.Up(), 1u);
+  EXPECT_EQ(decimator.TapsPerPhase(), 20u);
+
+  std::vector<double> out;
+  EXPECT_TRUE(decimator.Process(in, out));
+  const auto expected = Reference(in, 1, 4, taps);
+  ASSERT_EQ(out.size(), expected.size());
+  for (size_t i = 0; i < out.size(); ++i)
+    EXPECT_NEAR(out[i], expected[i], 1e-12);
+
+  // Default design passes DC
+  math::FirDecimator<float> defaultDecimator(5);
+  std::vector<float> ones(500, 1.0f);
+  std::vector<float> outf;
+  EXPECT_TRUE(defaultDecimator.Process(ones, outf));
+  EXPECT_EQ(outf.size(), 100u);
+  EXPECT_NEAR(outf.back(), 1.0f, 1e-5f);
+}
+
+/////////////////////////////////////////////////
+TEST(ResamplerTest, Rational)
+{
+  std::vector<double> in(300);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = std::sin(0.05 * i) + 0.1 * math::Rand::DblUniform(-1.0, 1.0);
+
+  for (auto ratio : {std::make_pair(3u, 2u), std::make_pair(2u, 3u),
+                     std::make_pair(5u, 1u), std::make_pair(4u, 7u)})
+  {
+    const unsigned int up = ratio.first;
+    const unsigned int down = ratio.second;
+    const auto taps = math::FirResamplingTaps(up, down, 10);
+    math::PolyphaseResampler<double> resampler(up, down, taps);
+
+    std::vector<double> out;
+    EXPECT_TRUE(resampler.Process(in, out));
+    const auto expected = Reference(in, up, down, taps);
+    ASSERT_EQ(out.size(), expected.size()) << up << "/" << down;
+    for (size_t i = 0; i < out.size(); ++i)
+      EXPECT_NEAR(out[i], expected[i], 1e-12) << up << "/" << down;
+  }
+}
+
+/////////////////////////////////////////////////
+TEST(ResamplerTest, BlocksAndChannels)
+{
+  const size_t channels = 3;
+  const size_t frames = 250;
+  std::vector<double> in(frames * channels);
+  for (auto &value : in)
+    value = math::Rand::DblUniform(-1.0, 1.0);
+
+  // Processing one block and processing many uneven blocks give the same
+  // result.
+  math::PolyphaseResampler<double> whole(3, 4, channels);
+  math::PolyphaseResampler<double> split(3, 4, channels);
+  EXPECT_EQ(whole.Channels(), channels);
+
+  std::vector<double> expected;
+  EXPECT_TRUE(whole.Process(in, expected));
+
+  std::vector<double> out;
+  std::vector<double> block;
+  size_t frame = 0;
+  size_t size = 1;
+  while (frame < frames)
+  {
+    const size_t n = std::min(size, frames - frame);
+    std::vector<double> chunk(in.begin() + frame * channels,
+        in.begin() + (frame + n) * channels);
+    EXPECT_TRUE(split.Process(chunk, block));
+    out.insert(out.end(), block.begin(), block.end());
+    frame += n;
+    size = size * 2 % 37 + 1;
+  }
+
+  ASSERT_EQ(out.size(), expected.size());
+  for (size_t i = 0; i < out.size(); ++i)
+    EXPECT_DOUBLE_EQ(out[i], expected[i]);
+
+  // Each channel matches a single channel resampler
+  for (size_t ch = 0; ch < channels; ++ch)
+  {
+    std::vector<double> single;
+    for (size_t f = 0; f < frames; ++f)
+      single.push_back(in[f * channels + ch]);
+    math::PolyphaseResampler<double> resampler(3, 4);
+    std::vector<double> singleOut;
+    EXPECT_TRUE(resampler.Process(single, singleOut));
+    ASSERT_EQ(singleOut.size() * channels, expected.size());
+    for (size_t i = 0; i < singleOut.size(); ++i)
+      EXPECT_DOUBLE_EQ(singleOut[i], expected[i * channels + ch]);
+  }
+
+  // Partial frames are rejected
+  in.pop_back();
+  EXPECT_FALSE(whole.Process(in, out));
+  EXPECT_TRUE(out.empty());
+
+  // Reset restarts the alignment
+  whole.Reset();
+  std::vector<double> zeros(4 * channels, 0.0);
+  EXPECT_TRUE(whole.Process(zeros, out));
+  EXPECT_EQ(out.size(), 3 * channels);
+}
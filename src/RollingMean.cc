@@ -15,29 +15,29 @@
  *
 */
 
-#include <numeric>
-#include <limits>
-#include <deque>
 #include "ignition/math/RollingMean.hh"
+#include "ignition/math/RollingWindowMean.hh"
 
 using namespace ignition::math;
 
 /// \brief Private data
 class ignition::math::RollingMeanPrivate
 {
-  /// \brief The window size
-  public: size_t windowSize{10};
+  /// \brief Constructor
+  /// \param[in] _windowSize The window size to use.
+  public: explicit RollingMeanPrivate(size_t _windowSize)
+    : mean(_windowSize)
+  {
+  }
 
-  /// \brief The values.
-  public: std::deque<double> values;
+  /// \brief The ring buffer and running sum.
+  public: RollingWindowMean<double> mean;
 };
 
 //////////////////////////////////////////////////
 RollingMean::RollingMean(size_t _windowSize)
-  : dataPtr(new RollingMeanPrivate)
+  : dataPtr(new RollingMeanPrivate(_windowSize))
 {
-  if (_windowSize > 0)
-    this->dataPtr->windowSize = _windowSize;
 }
 
 //////////////////////////////////////////////////
@@ -48,51 +48,35 @@ RollingMean::~RollingMean()
 //////////////////////////////////////////////////
 double RollingMean::Mean() const
 {
-  if (!this->dataPtr->values.empty())
-  {
-    return std::accumulate(
-        this->dataPtr->values.begin(), this->dataPtr->values.end(), 0.0) /
-      this->dataPtr->values.size();
-  }
-
-  return std::numeric_limits<double>::quiet_NaN();
+  return this->dataPtr->mean.Mean();
 }
 
 //////////////////////////////////////////////////
 size_t RollingMean::Count() const
 {
-  return this->dataPtr->values.size();
+  return this->dataPtr->mean.Count();
 }
 
 //////////////////////////////////////////////////
 void RollingMean::Push(double _value)
 {
-  this->dataPtr->values.push_back(_value);
-  while (this->dataPtr->values.size() > this->dataPtr->windowSize &&
-         !this->dataPtr->values.empty())
-  {
-    this->dataPtr->values.pop_front();
-  }
+  this->dataPtr->mean.Push(_value);
 }
 
 //////////////////////////////////////////////////
 void RollingMean::Clear()
 {
-  this->dataPtr->values.clear();
+  this->dataPtr->mean.Clear();
 }
 
 //////////////////////////////////////////////////
 void RollingMean::SetWindowSize(size_t _windowSize)
 {
-  if (_windowSize > 0)
-  {
-    this->dataPtr->windowSize = _windowSize;
-    this->Clear();
-  }
+  this->dataPtr->mean.SetWindowSize(_windowSize);
 }
 
 //////////////////////////////////////////////////
 size_t RollingMean::WindowSize() const
 {
-  return this->dataPtr->windowSize;
+  return this->dataPtr->mean.WindowSize();
 }
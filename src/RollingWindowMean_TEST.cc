@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/RollingWindowMean.hh"
+#include "ignition/math/Vector3.hh"
+
+using namespace ignition;
+
+/////////////////////////////////////////////////
+TEST(RollingWindowMeanTest, Double)
+{
+  math::RollingWindowMean<double> mean(0);
+  EXPECT_EQ(0u, mean.Count());
+  EXPECT_EQ(10u, mean.WindowSize());
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+
+  mean.SetWindowSize(3);
+  EXPECT_EQ(3u, mean.WindowSize());
+  mean.SetWindowSize(0);
+  EXPECT_EQ(3u, mean.WindowSize());
+
+  mean.Push(1.0);
+  EXPECT_DOUBLE_EQ(1.0, mean.Mean());
+  mean.Push(2.0);
+  EXPECT_DOUBLE_EQ(1.5, mean.Mean());
+  mean.Push(3.0);
+  EXPECT_DOUBLE_EQ(2.0, mean.Mean());
+  mean.Push(10.0);
+  EXPECT_DOUBLE_EQ(5.0, mean.Mean());
+  EXPECT_EQ(3u, mean.Count());
+
+  mean.Clear();
+  EXPECT_EQ(0u, mean.Count());
+  EXPECT_TRUE(math::isnan(mean.Mean()));
+  mean.Push(4.0);
+  EXPECT_DOUBLE_EQ(4.0, mean.Mean());
+}
+
+/////////////////////////////////////////////////
+TEST(RollingWindowMeanTest, Drift)
+{
+  // Large values followed by small ones would leave a rounding error in
+  // a naive running sum.
+  math::RollingWindowMean<double> mean(5);
+  for (int i = 0; i < 1000; ++i)
+    mean.Push(1e16 + i);
+  for (int i = 0; i < 1003; ++i)
+    mean.Push(0.1 * (i % 5));
+  EXPECT_NEAR(0.2, mean.Mean(), 1e-12);
+}
+
+/////////////////////////////////////////////////
+TEST(RollingWindowMeanTest, Vector3)
+{
+  math::RollingWindowMean<math::Vector3d> mean(2);
+  EXPECT_TRUE(math::isnan(mean.Mean().X()));
+  EXPECT_TRUE(math::isnan(mean.Mean().Y()));
+  EXPECT_TRUE(math::isnan(mean.Mean().Z()));
+
+  mean.Push(math::Vector3d(1, 2, 3));
+  EXPECT_EQ(math::Vector3d(1, 2, 3), mean.Mean());
+  mean.Push(math::Vector3d(3, 4, 5));
+  EXPECT_EQ(math::Vector3d(2, 3, 4), mean.Mean());
+  mean.Push(math::Vector3d(-3, -4, -5));
+  EXPECT_EQ(math::Vector3d(0, 0, 0), mean.Mean());
+  EXPECT_EQ(2u, mean.Count());
+}
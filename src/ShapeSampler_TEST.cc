@@ -0,0 +1,283 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/RandomGenerator.hh"
+#include "ignition/math/ShapeSampler.hh"
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(ShapeSamplerTest, Box)
+{
+  math::Xoshiro256PlusPlus engine(1);
+  math::ShapeSampler<math::Xoshiro256PlusPlus> sampler(engine);
+  const math::Boxd box(1.0, 2.0, 3.0);
+
+  std::vector<math::Vector3d> points(100000);
+  sampler.Volume(box, points);
+  EXPECT_EQ(points.size(), 100000u);
+  math::Vector3d sum;
+  for (const auto &point : points)
+  {
+    EXPECT_LE(std::abs(point.X()), 0.5);
+    EXPECT_LE(std::abs(point.Y()), 1.0);
+    EXPECT_LE(std::abs(point.Z()), 1.5);
+    sum += point;
+  }
+  EXPECT_NEAR(sum.Length() / points.size(), 0.0, 0.02);
+
+  // Faces are chosen by area: 6, 3 and 2 of a total of 11
+  sampler.Surface(box, points);
+  int faces[6] = {0, 0, 0, 0, 0, 0};
+  for (const auto &point : points)
+  {
+    if (math::equal(std::abs(point.X()), 0.5))
+      ++faces[point.X() < 0 ? 0 : 1];
+    else if (math::equal(std::abs(point.Y()), 1.0))
+      ++faces[point.Y() < 0 ? 2 : 3];
+    else if (math::equal(std::abs(point.Z()), 1.5))
+      ++faces[point.Z() < 0 ? 4 : 5];
+    else
+      ADD_FAILURE() << point;
+  }
+  const double n = static_cast<double>(points.size());
+  EXPECT_NEAR(faces[0] / n, 3.0 / 11, 0.01);
+  EXPECT_NEAR(faces[1] / n, 3.0 / 11, 0.01);
+  EXPECT_NEAR(faces[2] / n, 1.5 / 11, 0.01);
+  EXPECT_NEAR(faces[3] / n, 1.5 / 11, 0.01);
+  EXPECT_NEAR(faces[4] / n, 1.0 / 11, 0.01);
+  EXPECT_NEAR(faces[5] / n, 1.0 / 11, 0.01);
+}
+
+//////////////////////////////////////////////////
+TEST(ShapeSamplerTest, OrientedBox)
+{
+  std::mt19937 engine(2);
+  math::ShapeSampler<std::mt19937> sampler(engine);
+  const math::OrientedBoxd box(math::Vector3d(1, 2, 3),
+      math::Pose3d(4, 5, 6, 0.1, 0.2, 0.3));
+
+  std::vector<math::Vector3d> points(1000);
+  sampler.Volume(box, points);
+  for (const auto &point : points)
+    EXPECT_TRUE(box.Contains(point)) << point;
+
+  sampler.Surface(box, points);
+  for (const auto &point : points)
+  {
+    const math::Vector3d local =
+      box.Pose().Rot().RotateVectorReverse(point - box.Pose().Pos());
+    const double face = std::max({std::abs(local.X()) / 0.5,
+        std::abs(local.Y()) / 1.0, std::abs(local.Z()) / 1.5});
+    EXPECT_NEAR(face, 1.0, 1e-9);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(ShapeSamplerTest, Sphere)
+{
+  math::Xoshiro256PlusPlus engine(3);
+  math::ShapeSampler<math::Xoshiro256PlusPlus> sampler(engine);
+  const math::Sphered sphere(2.0);
+
+  std::vector<math::Vector3d> points(100000);
+  sampler.Volume(sphere, points);
+  int inner = 0;
+  for (const auto &point : points)
+  {
+    EXPECT_LE(point.Length(), 2.0);
+    inner += point.Length() < 1.0;
+  }
+  EXPECT_NEAR(inner / static_cast<double>(points.size()), 0.125, 0.005);
+
+  sampler.Surface(sphere, points);
+  int top = 0;
+  for (const auto &point : points)
+  {
+    EXPECT_NEAR(point.Length(), 2.0, 1e-12);
+    top += point.Z() > 1.0;
+  }
+
+  // Archimedes: a cap of height h has area 2 pi r h
+  EXPECT_NEAR(top / static_cast<double>(points.size()), 0.25, 0.005);
+}
+
+//////////////////////////////////////////////////
+TEST(ShapeSamplerTest, Cylinder)
+{
+  std::mt19937_64 engine(4);
+  math::ShapeSampler<std::mt19937_64> sampler(engine);
+  const math::Quaterniond rot(0.3, -0.2, 1.0);
+  const math::Cylinderd cylinder(2.0, 1.0, rot);
+
+  std::vector<math::Vector3d> points(100000);
+  sampler.Volume(cylinder, points);
+  int inner = 0;
+  for (const auto &point : points)
+  {
+    const math::Vector3d local = rot.RotateVectorReverse(point);
+    const double r = std::hypot(local.X(), local.Y());
+    EXPECT_LE(r, 1.0 + 1e-12);
+    EXPECT_LE(std::abs(local.Z()), 1.0 + 1e-12);
+    inner += r < 0.5;
+  }
+  EXPECT_NEAR(inner / static_cast<double>(points.size()), 0.25, 0.005);
+
+  // Side area 4 pi, caps 2 pi
+  sampler.Surface(cylinder, points);
+  int side = 0;
+  for (const auto &point : points)
+  {
+    const math::Vector3d local = rot.RotateVectorReverse(point);
+    const double r = std::hypot(local.X(), local.Y());
+    if (std::abs(r - 1.0) < 1e-9)
+    {
+      ++side;
+      EXPECT_LE(std::abs(local.Z()), 1.0 + 1e-9);
+    }
+    else
+    {
+      EXPECT_NEAR(std::abs(local.Z()), 1.0, 1e-9);
+      EXPECT_LE(r, 1.0);
+    }
+  }
+  EXPECT_NEAR(side / static_cast<double>(points.size()), 2.0 / 3, 0.01);
+}
+
+//////////////////////////////////////////////////
+TEST(ShapeSamplerTest, Capsule)
+{
+  math::Xoshiro256PlusPlus engine(5);
+  math::ShapeSampler<math::Xoshiro256PlusPlus> sampler(engine);
+  const math::Capsuled capsule(2.0, 0.5);
+
+  // Distance to the axis segment
+  auto distance = [](const math::Vector3d &_p)
+  {
+    const double z = std::max(-1.0, std::min(1.0, _p.Z()));
+    return _p.Distance(math::Vector3d(0, 0, z));
+  };
+
+  std::vector<math::Vector3d> points(100000);
+  sampler.Volume(capsule, points);
+  int cylinder = 0;
+  for (const auto &point : points)
+  {
+    EXPECT_LE(distance(point), 0.5 + 1e-12);
+    cylinder += std::abs(point.Z()) <= 1.0;
+  }
+
+  // Volumes pi r^2 l and 4/3 pi r^3
+  const double n = static_cast<double>(points.size());
+  EXPECT_NEAR(cylinder / n, 2.0 / (2.0 + 2.0 / 3), 0.01);
+
+  sampler.Surface(capsule, points);
+  cylinder = 0;
+  for (const auto &point : points)
+  {
+    EXPECT_NEAR(distance(point), 0.5, 1e-9);
+    cylinder += std::abs(point.Z()) <= 1.0;
+  }
+
+  // Areas 2 pi r l and 4 pi r^2
+  EXPECT_NEAR(cylinder / n, 2.0 / 3.0, 0.01);
+}
+
+//////////////////////////////////////////////////
+TEST(ShapeSamplerTest, Ellipsoid)
+{
+  std::minstd_rand engine(6);
+  math::ShapeSampler<std::minstd_rand> sampler(engine);
+  const math::Vector3d radii(1.0, 2.0, 3.0);
+  const math::Ellipsoidd ellipsoid(radii);
+
+  std::vector<math::Vector3d> points(20000);
+  sampler.Volume(ellipsoid, points);
+  int inner = 0;
+  for (const auto &point : points)
+  {
+    const double r = (point / radii).Length();
+    EXPECT_LE(r, 1.0);
+    inner += r < 0.5;
+  }
+  EXPECT_NEAR(inner / static_cast<double>(points.size()), 0.125, 0.01);
+
+  sampler.Surface(ellipsoid, points);
+  for (const auto &point : points)
+    EXPECT_NEAR((point / radii).Length(), 1.0, 1e-9);
+
+  // A flat ellipsoid is close to two discs, so a quarter of the area is
+  // within half the radius of the axis.
+  sampler.Surface(math::Ellipsoidd(math::Vector3d(2, 2, 1e-4)), points);
+  int center = 0;
+  for (const auto &point : points)
+    center += std::hypot(point.X(), point.Y()) < 1.0;
+  EXPECT_NEAR(center / static_cast<double>(points.size()), 0.25, 0.01);
+}
+
+//////////////////////////////////////////////////
+TEST(ShapeSamplerTest, Triangle)
+{
+  math::Xoshiro256PlusPlus engine(7);
+  math::ShapeSampler<math::Xoshiro256PlusPlus> sampler(engine);
+  const math::Triangle3d triangle(math::Vector3d(1, 0, 0),
+      math::Vector3d(0, 2, 0), math::Vector3d(0, 0, 3));
+
+  std::vector<math::Vector3d> points(100000);
+  sampler.Surface(triangle, points);
+  int corner = 0;
+  for (const auto &point : points)
+  {
+    // The barycentric coordinate of the first corner is x
+    EXPECT_NEAR(point.X() + point.Y() / 2 + point.Z() / 3, 1.0, 1e-12);
+    EXPECT_GE(point.X(), 0.0);
+    EXPECT_GE(point.Y(), 0.0);
+    EXPECT_GE(point.Z(), 0.0);
+    corner += point.X() > 0.5;
+  }
+  EXPECT_NEAR(corner / static_cast<double>(points.size()), 0.25, 0.005);
+}
+
+//////////////////////////////////////////////////
+TEST(ShapeSamplerTest, Float)
+{
+  math::RandomGenerator generator(8);
+  math::ShapeSampler<math::GeneratorType> sampler(generator.Generator());
+
+  std::vector<math::Vector3f> points(1000);
+  sampler.Volume(math::Boxf(1, 1, 1), points);
+  for (const auto &point : points)
+  {
+    EXPECT_LT(point.X(), 0.5f);
+    EXPECT_GE(point.X(), -0.5f);
+  }
+  sampler.Surface(math::Spheref(1), points);
+  for (const auto &point : points)
+    EXPECT_NEAR(point.Length(), 1.0f, 1e-5f);
+
+  // Empty vectors are left empty
+  std::vector<math::Vector3f> empty;
+  sampler.Volume(math::Spheref(1), empty);
+  EXPECT_TRUE(empty.empty());
+}
@@ -14,14 +14,226 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
 #include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
 #include <iostream>
+#include <limits>
+#include <sstream>
+#include <typeinfo>
 #include <ignition/math/SignalStats.hh>
+#include "ParallelInsert.hh"
 #include "SignalStatsPrivate.hh"
 
 using namespace ignition;
 using namespace math;
 
+namespace
+{
+  /// \brief Number of independent accumulators used by the block kernels.
+  /// Splitting a reduction into several lanes removes the loop-carried
+  /// dependency on a single accumulator, which lets the compiler vectorize
+  /// the loop.
+  const size_t kLanes = 4;
+
+  //////////////////////////////////////////////////
+  /// \brief Reduce a block of samples using kLanes accumulators.
+  /// \param[in] _data Array of _count samples.
+  /// \param[in] _count Number of samples, must not be zero.
+  /// \param[in] _init Initial value of each accumulator.
+  /// \param[in] _op Function that folds a sample into an accumulator.
+  /// \param[in] _combine Function that combines two accumulators.
+  /// \return The reduced value.
+  template<typename Op, typename Combine>
+  double Reduce(const double *_data, const size_t _count, const double _init,
+      Op _op, Combine _combine)
+  {
+    double acc[kLanes];
+    for (size_t j = 0; j < kLanes; ++j)
+      acc[j] = _init;
+
+    const size_t blocked = _count - _count % kLanes;
+    for (size_t i = 0; i < blocked; i += kLanes)
+    {
+      for (size_t j = 0; j < kLanes; ++j)
+        acc[j] = _op(acc[j], _data[i + j]);
+    }
+    for (size_t i = blocked; i < _count; ++i)
+      acc[0] = _op(acc[0], _data[i]);
+
+    return _combine(_combine(acc[0], acc[1]), _combine(acc[2], acc[3]));
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Combine the count, mean and M2 of a set of samples into the
+  /// state of a SignalVariance using the parallel algorithm of Chan et al.
+  /// wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
+  /// \param[in, out] _data State of the variance, where data is M2 and
+  /// extraData is the mean.
+  /// \param[in] _countB Number of samples to combine.
+  /// \param[in] _meanB Mean of the samples to combine.
+  /// \param[in] _m2B Sum of squared differences from _meanB.
+  void CombineVariance(SignalStatisticPrivate &_data,
+      const uint64_t _countB, const double _meanB, const double _m2B)
+  {
+    if (_countB == 0)
+      return;
+
+    const double countA = static_cast<double>(_data.count);
+    const double countB = static_cast<double>(_countB);
+    const double count = countA + countB;
+
+    // delta = meanB - meanA
+    const double delta = _meanB - _data.extraData;
+
+    // mean = meanA + delta * nB / n
+    _data.extraData += delta * countB / count;
+
+    // M2 = M2A + M2B + delta^2 * nA * nB / n
+    _data.data += _m2B + delta * delta * countA * countB / count;
+
+    _data.count += _countB;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Check if two values are exactly equal, without the
+  /// tolerance of math::equal.
+  /// \param[in] _a First value.
+  /// \param[in] _b Second value.
+  /// \return True if neither value is less than the other.
+  bool SameValue(const double _a, const double _b)
+  {
+    return !(_a < _b) && !(_b < _a);
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Parse the name of a quantile statistic.
+  /// \param[in] _name Name such as "p99" or "quantile:0.999".
+  /// \param[out] _quantile Parsed quantile in the range [0, 1].
+  /// \return True if _name is a valid quantile name.
+  bool ParseQuantile(const std::string &_name, double &_quantile)
+  {
+    const std::string kQuantilePrefix = "quantile:";
+    std::string number;
+    std::string exponent;
+    if (_name.size() > 1 && _name[0] == 'p')
+    {
+      // Scale percentiles with the exponent so that the decimal number is
+      // rounded once, for example "p99.9" gives the same quantile as
+      // "quantile:0.999".
+      number = _name.substr(1);
+      exponent = "e-2";
+    }
+    else if (_name.compare(0, kQuantilePrefix.size(), kQuantilePrefix) == 0)
+    {
+      number = _name.substr(kQuantilePrefix.size());
+    }
+    else
+    {
+      return false;
+    }
+
+    if (number.empty() ||
+        number.find_first_not_of("0123456789.") != std::string::npos)
+    {
+      return false;
+    }
+
+    number += exponent;
+    char *end = nullptr;
+    const double value = std::strtod(number.c_str(), &end);
+    if (end != number.c_str() + number.size() || value < 0 || value > 1)
+      return false;
+
+    _quantile = value;
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Parse the name of a windowed statistic.
+  /// \param[in] _name Name such as "windowMean:100".
+  /// \param[in] _prefix Expected prefix, such as "windowMean:".
+  /// \param[out] _windowSize Parsed window size.
+  /// \return True if _name starts with _prefix followed by a positive
+  /// window size.
+  bool ParseWindow(const std::string &_name, const std::string &_prefix,
+      size_t &_windowSize)
+  {
+    if (_name.size() <= _prefix.size() ||
+        _name.compare(0, _prefix.size(), _prefix) != 0 ||
+        _name.find_first_not_of("0123456789", _prefix.size()) !=
+        std::string::npos)
+    {
+      return false;
+    }
+
+    char *end = nullptr;
+    const unsigned long long windowSize =
+      std::strtoull(_name.c_str() + _prefix.size(), &end, 10);
+    if (*end != '\0' || windowSize == 0)
+      return false;
+
+    _windowSize = static_cast<size_t>(windowSize);
+    return true;
+  }
+
+  //////////////////////////////////////////////////
+  /// \brief Push a sample into the monotonic queue of a windowed minimum
+  /// or maximum. The sample must already be stored in the ring buffer.
+  /// \param[in, out] _data Window data.
+  /// \param[in] _sample Number of the new sample.
+  /// \param[in] _before Function that returns true if the first value
+  /// must stay in front of the second one, std::greater for a maximum.
+  template<typename Before>
+  void PushMonotonic(SignalWindowPrivate &_data, const uint64_t _sample,
+      Before _before)
+  {
+    const size_t windowSize = _data.values.size();
+
+    // Drop the front if it left the window
+    if (_data.queueSize > 0 &&
+        _data.queue[_data.queueFront] + windowSize <= _sample)
+    {
+      _data.queueFront = (_data.queueFront + 1) % windowSize;
+      --_data.queueSize;
+    }
+
+    // Drop samples from the back that can no longer be the extreme value
+    const double value = _data.values[_sample % windowSize];
+    while (_data.queueSize > 0)
+    {
+      const size_t back = (_data.queueFront + _data.queueSize - 1) %
+        windowSize;
+      if (_before(_data.values[_data.queue[back] % windowSize], value))
+        break;
+      --_data.queueSize;
+    }
+
+    _data.queue[(_data.queueFront + _data.queueSize) % windowSize] = _sample;
+    ++_data.queueSize;
+  }
+
+  //////////////////////////////////////////////////
+  double Add(const double _a, const double _b)
+  {
+    return _a + _b;
+  }
+
+  //////////////////////////////////////////////////
+  double Greater(const double _a, const double _b)
+  {
+    return _b > _a ? _b : _a;
+  }
+
+  //////////////////////////////////////////////////
+  double Lesser(const double _a, const double _b)
+  {
+    return _b < _a ? _b : _a;
+  }
+}
+
 //////////////////////////////////////////////////
 SignalStatistic::SignalStatistic()
   : dataPtr(new SignalStatisticPrivate)
@@ -45,7 +257,7 @@ SignalStatistic::SignalStatistic(const SignalStatistic &_ss)
 //////////////////////////////////////////////////
 size_t SignalStatistic::Count() const
 {
-  return this->dataPtr->count;
+  return static_cast<size_t>(this->dataPtr->count);
 }
 
 //////////////////////////////////////////////////
@@ -204,6 +416,581 @@ void SignalVariance::InsertData(const double _data)
   this->dataPtr->data += delta * (_data - this->dataPtr->extraData);
 }
 
+//////////////////////////////////////////////////
+// Number of centroids is bounded by about kCompression * pi / 2
+static const double kCompression = 100;
+
+// Number of samples that are buffered before they are merged into the digest
+static const size_t kQuantileBufferSize = 500;
+
+//////////////////////////////////////////////////
+void SignalQuantilePrivate::Add(const Centroid &_centroid)
+{
+  if (this->centroids.empty() && this->buffer.empty())
+  {
+    this->min = _centroid.mean;
+    this->max = _centroid.mean;
+  }
+  else
+  {
+    this->min = std::min(this->min, _centroid.mean);
+    this->max = std::max(this->max, _centroid.mean);
+  }
+
+  this->buffer.push_back(_centroid);
+  if (this->buffer.size() >= kQuantileBufferSize)
+    this->Compress();
+}
+
+//////////////////////////////////////////////////
+void SignalQuantilePrivate::Compress()
+{
+  if (this->buffer.empty())
+    return;
+
+  auto lessMean = [](const Centroid &_a, const Centroid &_b)
+  {
+    return _a.mean < _b.mean;
+  };
+  std::sort(this->buffer.begin(), this->buffer.end(), lessMean);
+
+  double total = this->totalWeight;
+  for (auto const &centroid : this->buffer)
+    total += centroid.weight;
+
+  this->scratch.clear();
+  std::merge(this->centroids.begin(), this->centroids.end(),
+      this->buffer.begin(), this->buffer.end(),
+      std::back_inserter(this->scratch), lessMean);
+
+  // The k1 scale function of the t-digest. Two neighboring centroids can
+  // be merged if the result spans at most one unit of k, which keeps the
+  // centroids near the tails small.
+  auto scale = [](const double _q)
+  {
+    return kCompression / (2.0 * IGN_PI) *
+      std::asin(clamp(2.0 * _q - 1.0, -1.0, 1.0));
+  };
+
+  this->centroids.clear();
+  Centroid current = this->scratch.front();
+  double weightSoFar = 0;
+  for (size_t i = 1; i < this->scratch.size(); ++i)
+  {
+    const Centroid &next = this->scratch[i];
+    const double proposed = current.weight + next.weight;
+    if (scale((weightSoFar + proposed) / total) -
+        scale(weightSoFar / total) <= 1.0)
+    {
+      current.mean += (next.mean - current.mean) * next.weight / proposed;
+      current.weight = proposed;
+    }
+    else
+    {
+      this->centroids.push_back(current);
+      weightSoFar += current.weight;
+      current = next;
+    }
+  }
+  this->centroids.push_back(current);
+
+  this->totalWeight = total;
+  this->buffer.clear();
+}
+
+//////////////////////////////////////////////////
+double SignalQuantilePrivate::Value(const double _quantile) const
+{
+  // Compress a copy when samples are buffered, so that reading a const
+  // SignalQuantile never modifies it.
+  if (!this->buffer.empty())
+  {
+    SignalQuantilePrivate compressed(*this);
+    compressed.Compress();
+    return compressed.Value(_quantile);
+  }
+
+  if (this->centroids.empty())
+    return 0;
+
+  const double index = clamp(_quantile, 0.0, 1.0) * this->totalWeight;
+
+  // Interpolate between the min and the center of the first centroid
+  const Centroid &first = this->centroids.front();
+  if (index < first.weight / 2)
+    return this->min + (first.mean - this->min) * index / (first.weight / 2);
+
+  // Interpolate between the center of the last centroid and the max
+  const Centroid &last = this->centroids.back();
+  if (index > this->totalWeight - last.weight / 2)
+  {
+    return this->max - (this->max - last.mean) *
+      (this->totalWeight - index) / (last.weight / 2);
+  }
+
+  // Interpolate between the centers of neighboring centroids
+  double center = first.weight / 2;
+  for (size_t i = 0; i + 1 < this->centroids.size(); ++i)
+  {
+    const Centroid &left = this->centroids[i];
+    const Centroid &right = this->centroids[i + 1];
+    const double nextCenter = center + (left.weight + right.weight) / 2;
+    if (index <= nextCenter)
+    {
+      return left.mean + (right.mean - left.mean) *
+        (index - center) / (nextCenter - center);
+    }
+    center = nextCenter;
+  }
+  return last.mean;
+}
+
+//////////////////////////////////////////////////
+void SignalQuantilePrivate::Reset()
+{
+  this->centroids.clear();
+  this->buffer.clear();
+  this->min = 0.0;
+  this->max = 0.0;
+  this->totalWeight = 0.0;
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::SignalQuantile(double _quantile)
+  : quantileDataPtr(new SignalQuantilePrivate)
+{
+  this->quantileDataPtr->quantile = clamp(_quantile, 0.0, 1.0);
+  this->quantileDataPtr->buffer.reserve(kQuantileBufferSize);
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::SignalQuantile(const SignalQuantile &_sq)
+  : SignalStatistic(_sq),
+    quantileDataPtr(new SignalQuantilePrivate(*_sq.quantileDataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+SignalQuantile::~SignalQuantile()
+{
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Quantile() const
+{
+  return this->quantileDataPtr->quantile;
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Value() const
+{
+  return this->quantileDataPtr->Value(this->quantileDataPtr->quantile);
+}
+
+//////////////////////////////////////////////////
+double SignalQuantile::Value(const double _quantile) const
+{
+  return this->quantileDataPtr->Value(_quantile);
+}
+
+//////////////////////////////////////////////////
+std::string SignalQuantile::ShortName() const
+{
+  // The name is parsed by SignalStats::InsertStatistic, so it must give
+  // back exactly the same quantile.
+  const double quantile = this->quantileDataPtr->quantile;
+  const double percent = std::round(quantile * 100);
+  if (SameValue(percent / 100, quantile))
+    return "p" + std::to_string(static_cast<int>(percent));
+
+  // Use the shortest precision that round-trips, up to max_digits10
+  std::string name;
+  for (int precision = std::numeric_limits<double>::digits10;
+       precision <= std::numeric_limits<double>::max_digits10; ++precision)
+  {
+    std::ostringstream stream;
+    stream << std::setprecision(precision) << quantile;
+    name = stream.str();
+    if (SameValue(std::strtod(name.c_str(), nullptr), quantile))
+      break;
+  }
+  return "quantile:" + name;
+}
+
+//////////////////////////////////////////////////
+void SignalQuantile::InsertData(const double _data)
+{
+  this->quantileDataPtr->Add({_data, 1.0});
+  this->dataPtr->count++;
+}
+
+//////////////////////////////////////////////////
+void SignalQuantile::Reset()
+{
+  SignalStatistic::Reset();
+  this->quantileDataPtr->Reset();
+}
+
+//////////////////////////////////////////////////
+SignalWindowStatistic::SignalWindowStatistic(size_t _windowSize)
+  : windowDataPtr(new SignalWindowPrivate)
+{
+  this->windowDataPtr->values.resize(std::max<size_t>(1u, _windowSize));
+}
+
+//////////////////////////////////////////////////
+SignalWindowStatistic::SignalWindowStatistic(
+    const SignalWindowStatistic &_sws)
+  : SignalStatistic(_sws),
+    windowDataPtr(new SignalWindowPrivate(*_sws.windowDataPtr))
+{
+}
+
+//////////////////////////////////////////////////
+SignalWindowStatistic::~SignalWindowStatistic()
+{
+}
+
+//////////////////////////////////////////////////
+size_t SignalWindowStatistic::WindowSize() const
+{
+  return this->windowDataPtr->values.size();
+}
+
+//////////////////////////////////////////////////
+size_t SignalWindowStatistic::WindowCount() const
+{
+  return static_cast<size_t>(std::min<uint64_t>(
+      this->windowDataPtr->samples, this->windowDataPtr->values.size()));
+}
+
+//////////////////////////////////////////////////
+void SignalWindowStatistic::Reset()
+{
+  SignalStatistic::Reset();
+  const size_t windowSize = this->windowDataPtr->values.size();
+  const bool hasQueue = !this->windowDataPtr->queue.empty();
+  *this->windowDataPtr = SignalWindowPrivate();
+  this->windowDataPtr->values.resize(windowSize);
+  if (hasQueue)
+    this->windowDataPtr->queue.resize(windowSize);
+}
+
+//////////////////////////////////////////////////
+SignalWindowMaximum::SignalWindowMaximum(size_t _windowSize)
+  : SignalWindowStatistic(_windowSize)
+{
+  this->windowDataPtr->queue.resize(this->WindowSize());
+}
+
+//////////////////////////////////////////////////
+double SignalWindowMaximum::Value() const
+{
+  if (this->windowDataPtr->queueSize == 0)
+    return 0.0;
+
+  const size_t windowSize = this->windowDataPtr->values.size();
+  return this->windowDataPtr->values[
+    this->windowDataPtr->queue[this->windowDataPtr->queueFront] % windowSize];
+}
+
+//////////////////////////////////////////////////
+std::string SignalWindowMaximum::ShortName() const
+{
+  return "windowMax:" + std::to_string(this->WindowSize());
+}
+
+//////////////////////////////////////////////////
+void SignalWindowMaximum::InsertData(const double _data)
+{
+  SignalWindowPrivate &window = *this->windowDataPtr;
+  const uint64_t sample = window.samples++;
+  window.values[sample % window.values.size()] = _data;
+  PushMonotonic(window, sample, std::greater<double>());
+  this->dataPtr->count++;
+}
+
+//////////////////////////////////////////////////
+SignalWindowMean::SignalWindowMean(size_t _windowSize)
+  : SignalWindowStatistic(_windowSize)
+{
+}
+
+//////////////////////////////////////////////////
+double SignalWindowMean::Value() const
+{
+  const size_t count = this->WindowCount();
+  if (count == 0)
+    return 0.0;
+  return this->windowDataPtr->sum / count;
+}
+
+//////////////////////////////////////////////////
+std::string SignalWindowMean::ShortName() const
+{
+  return "windowMean:" + std::to_string(this->WindowSize());
+}
+
+//////////////////////////////////////////////////
+void SignalWindowMean::InsertData(const double _data)
+{
+  SignalWindowPrivate &window = *this->windowDataPtr;
+  const size_t windowSize = window.values.size();
+  const uint64_t sample = window.samples++;
+  double &slot = window.values[sample % windowSize];
+
+  if (sample >= windowSize)
+    window.sum -= slot;
+  window.sum += _data;
+  slot = _data;
+
+  // Recompute the sum once per window to bound the rounding error that
+  // accumulates from the subtractions. This keeps the update amortized
+  // constant time.
+  if (sample % windowSize == windowSize - 1)
+  {
+    window.sum = 0.0;
+    for (const double value : window.values)
+      window.sum += value;
+  }
+  this->dataPtr->count++;
+}
+
+//////////////////////////////////////////////////
+SignalWindowMinimum::SignalWindowMinimum(size_t _windowSize)
+  : SignalWindowStatistic(_windowSize)
+{
+  this->windowDataPtr->queue.resize(this->WindowSize());
+}
+
+//////////////////////////////////////////////////
+double SignalWindowMinimum::Value() const
+{
+  if (this->windowDataPtr->queueSize == 0)
+    return 0.0;
+
+  const size_t windowSize = this->windowDataPtr->values.size();
+  return this->windowDataPtr->values[
+    this->windowDataPtr->queue[this->windowDataPtr->queueFront] % windowSize];
+}
+
+//////////////////////////////////////////////////
+std::string SignalWindowMinimum::ShortName() const
+{
+  return "windowMin:" + std::to_string(this->WindowSize());
+}
+
+//////////////////////////////////////////////////
+void SignalWindowMinimum::InsertData(const double _data)
+{
+  SignalWindowPrivate &window = *this->windowDataPtr;
+  const uint64_t sample = window.samples++;
+  window.values[sample % window.values.size()] = _data;
+  PushMonotonic(window, sample, std::less<double>());
+  this->dataPtr->count++;
+}
+
+//////////////////////////////////////////////////
+SignalWindowVariance::SignalWindowVariance(size_t _windowSize)
+  : SignalWindowStatistic(_windowSize)
+{
+}
+
+//////////////////////////////////////////////////
+double SignalWindowVariance::Value() const
+{
+  const size_t count = this->WindowCount();
+  if (count < 2)
+    return 0.0;
+
+  // variance = M2 / (n - 1), M2 can become slightly negative due to
+  // rounding when all the samples in the window are equal.
+  return std::max(0.0, this->windowDataPtr->m2 / (count - 1));
+}
+
+//////////////////////////////////////////////////
+std::string SignalWindowVariance::ShortName() const
+{
+  return "windowVar:" + std::to_string(this->WindowSize());
+}
+
+//////////////////////////////////////////////////
+void SignalWindowVariance::InsertData(const double _data)
+{
+  SignalWindowPrivate &window = *this->windowDataPtr;
+  const size_t windowSize = window.values.size();
+  const uint64_t sample = window.samples++;
+  double &slot = window.values[sample % windowSize];
+
+  if (sample < windowSize)
+  {
+    // Same online algorithm as SignalVariance::InsertData
+    const double delta = _data - window.mean;
+    window.mean += delta / (sample + 1);
+    window.m2 += delta * (_data - window.mean);
+  }
+  else
+  {
+    // Replace the oldest sample, keeping the count constant
+    const double oldest = slot;
+    const double delta = _data - oldest;
+    const double oldMean = window.mean;
+    window.mean += delta / windowSize;
+    window.m2 += delta * (_data - window.mean + oldest - oldMean);
+  }
+  slot = _data;
+
+  // Recompute the mean and M2 once per window to bound the rounding error
+  // of the sliding updates. This keeps the update amortized constant time.
+  if (sample % windowSize == windowSize - 1)
+  {
+    double sum = 0.0;
+    for (const double value : window.values)
+      sum += value;
+    window.mean = sum / windowSize;
+    window.m2 = 0.0;
+    for (const double value : window.values)
+      window.m2 += (value - window.mean) * (value - window.mean);
+  }
+  this->dataPtr->count++;
+}
+
+//////////////////////////////////////////////////
+void SignalStatsPrivate::InsertData(const double *_data, const size_t _count)
+{
+  if (_count == 0)
+    return;
+
+  for (auto &statistic : this->stats)
+  {
+    // Compare exact types, so that subclasses that override InsertData
+    // still insert the samples one at a time.
+    SignalStatistic *stat = statistic.get();
+    SignalStatisticPrivate &state = *stat->dataPtr;
+    const std::type_info &type = typeid(*stat);
+    if (type == typeid(SignalMaximum))
+    {
+      const double max = Reduce(_data, _count, _data[0], Greater, Greater);
+      if (state.count == 0 || max > state.data)
+        state.data = max;
+      state.count += _count;
+    }
+    else if (type == typeid(SignalMean))
+    {
+      state.data += Reduce(_data, _count, 0.0, Add, Add);
+      state.count += _count;
+    }
+    else if (type == typeid(SignalMinimum))
+    {
+      const double min = Reduce(_data, _count, _data[0], Lesser, Lesser);
+      if (state.count == 0 || min < state.data)
+        state.data = min;
+      state.count += _count;
+    }
+    else if (type == typeid(SignalRootMeanSquare))
+    {
+      state.data += Reduce(_data, _count, 0.0,
+          [](const double _acc, const double _x) {return _acc + _x * _x;},
+          Add);
+      state.count += _count;
+    }
+    else if (type == typeid(SignalMaxAbsoluteValue))
+    {
+      const double maxAbs = Reduce(_data, _count, 0.0,
+          [](const double _acc, const double _x)
+          {
+            const double absX = std::abs(_x);
+            return absX > _acc ? absX : _acc;
+          }, Greater);
+      if (maxAbs > state.data)
+        state.data = maxAbs;
+      state.count += _count;
+    }
+    else if (type == typeid(SignalVariance))
+    {
+      // Two-pass mean and M2 of the block, combined with the current state
+      // using the parallel algorithm of Chan et al.
+      const double meanB = Reduce(_data, _count, 0.0, Add, Add) / _count;
+      const double m2B = Reduce(_data, _count, 0.0,
+          [meanB](const double _acc, const double _x)
+          {
+            const double delta = _x - meanB;
+            return _acc + delta * delta;
+          }, Add);
+      CombineVariance(state, _count, meanB, m2B);
+    }
+    else
+    {
+      for (size_t i = 0; i < _count; ++i)
+        stat->InsertData(_data[i]);
+    }
+  }
+}
+
+//////////////////////////////////////////////////
+bool SignalStatsPrivate::Merge(SignalStatistic &_to,
+    const SignalStatistic &_from)
+{
+  if (typeid(_to) != typeid(_from))
+    return false;
+
+  // Copy the other state first in case _from is _to
+  SignalStatisticPrivate &to = *_to.dataPtr;
+  const SignalStatisticPrivate from = *_from.dataPtr;
+  if (dynamic_cast<SignalMaximum *>(&_to))
+  {
+    if (from.count > 0 && (to.count == 0 || from.data > to.data))
+      to.data = from.data;
+    to.count += from.count;
+  }
+  else if (dynamic_cast<SignalMean *>(&_to) ||
+           dynamic_cast<SignalRootMeanSquare *>(&_to))
+  {
+    to.data += from.data;
+    to.count += from.count;
+  }
+  else if (dynamic_cast<SignalMinimum *>(&_to))
+  {
+    if (from.count > 0 && (to.count == 0 || from.data < to.data))
+      to.data = from.data;
+    to.count += from.count;
+  }
+  else if (dynamic_cast<SignalMaxAbsoluteValue *>(&_to))
+  {
+    if (from.data > to.data)
+      to.data = from.data;
+    to.count += from.count;
+  }
+  else if (dynamic_cast<SignalVariance *>(&_to))
+  {
+    CombineVariance(to, from.count, from.extraData, from.data);
+  }
+  else if (auto quantile = dynamic_cast<SignalQuantile *>(&_to))
+  {
+    if (from.count == 0)
+      return true;
+
+    SignalQuantilePrivate &digest = *quantile->quantileDataPtr;
+    const SignalQuantilePrivate fromDigest =
+      *static_cast<const SignalQuantile &>(_from).quantileDataPtr;
+    for (auto const &centroid : fromDigest.centroids)
+      digest.Add(centroid);
+    for (auto const &centroid : fromDigest.buffer)
+      digest.Add(centroid);
+
+    // Centroids only carry their mean, so restore the extreme values
+    digest.min = std::min(digest.min, fromDigest.min);
+    digest.max = std::max(digest.max, fromDigest.max);
+    digest.Compress();
+    to.count += from.count;
+  }
+  else
+  {
+    return false;
+  }
+  return true;
+}
+
 //////////////////////////////////////////////////
 SignalStats::SignalStats()
   : dataPtr(new SignalStatsPrivate)
@@ -251,22 +1038,72 @@ void SignalStats::InsertData(const double _data)
 }
 
 //////////////////////////////////////////////////
-bool SignalStats::InsertStatistic(const std::string &_name)
+void SignalStats::InsertData(const std::vector<double> &_data)
+{
+  this->dataPtr->InsertData(_data.data(), _data.size());
+}
+
+//////////////////////////////////////////////////
+bool SignalStats::InsertDataParallel(const std::vector<double> &_data,
+    unsigned int _threadCount)
+{
+  std::vector<std::string> names;
+  for (auto const &statistic : this->dataPtr->stats)
+    names.push_back(statistic->ShortName());
+
+  return ParallelInsert(*this, _data.data(), _data.size(), _threadCount,
+      [&names](SignalStats &_stats)
+      {
+        for (auto const &name : names)
+          _stats.InsertStatistic(name);
+      },
+      [](SignalStats &_stats, const double *_samples, size_t _count)
+      {
+        _stats.dataPtr->InsertData(_samples, _count);
+      });
+}
+
+//////////////////////////////////////////////////
+bool SignalStats::Merge(const SignalStats &_other)
 {
-  // Check if the statistic is already inserted
+  if (this->dataPtr->stats.size() != _other.dataPtr->stats.size())
+    return false;
+
+  // Merge into new statistics so that nothing is modified on failure.
+  SignalStats merged;
+  for (auto const &statistic : this->dataPtr->stats)
   {
-    auto map = this->Map();
-    if (map.find(_name) != map.end())
+    const std::string name = statistic->ShortName();
+    auto otherIter = std::find_if(_other.dataPtr->stats.begin(),
+        _other.dataPtr->stats.end(),
+        [&name](const SignalStatisticPtr &_s)
+        {
+          return _s->ShortName() == name;
+        });
+    if (otherIter == _other.dataPtr->stats.end() ||
+        !merged.InsertStatistic(name))
+    {
+      return false;
+    }
+
+    auto &mergedStatistic = merged.dataPtr->stats.back();
+    if (!SignalStatsPrivate::Merge(*mergedStatistic, *statistic) ||
+        !SignalStatsPrivate::Merge(*mergedStatistic, **otherIter))
     {
-      std::cerr << "Unable to InsertStatistic ["
-                << _name
-                << "] since it has already been inserted."
-                << std::endl;
       return false;
     }
   }
 
+  this->dataPtr = std::move(merged.dataPtr);
+  return true;
+}
+
+//////////////////////////////////////////////////
+bool SignalStats::InsertStatistic(const std::string &_name)
+{
   SignalStatisticPtr stat;
+  double quantile;
+  size_t windowSize;
   if (_name == "max")
   {
     stat.reset(new SignalMaximum());
@@ -291,6 +1128,26 @@ bool SignalStats::InsertStatistic(const std::string &_name)
   {
     stat.reset(new SignalVariance());
   }
+  else if (ParseQuantile(_name, quantile))
+  {
+    stat.reset(new SignalQuantile(quantile));
+  }
+  else if (ParseWindow(_name, "windowMax:", windowSize))
+  {
+    stat.reset(new SignalWindowMaximum(windowSize));
+  }
+  else if (ParseWindow(_name, "windowMean:", windowSize))
+  {
+    stat.reset(new SignalWindowMean(windowSize));
+  }
+  else if (ParseWindow(_name, "windowMin:", windowSize))
+  {
+    stat.reset(new SignalWindowMinimum(windowSize));
+  }
+  else if (ParseWindow(_name, "windowVar:", windowSize))
+  {
+    stat.reset(new SignalWindowVariance(windowSize));
+  }
   else
   {
     // Unrecognized name string
@@ -300,6 +1157,21 @@ bool SignalStats::InsertStatistic(const std::string &_name)
               << std::endl;
     return false;
   }
+
+  // Check if the statistic is already inserted. This compares short names
+  // since different names can refer to the same quantile.
+  {
+    auto map = this->Map();
+    if (map.find(stat->ShortName()) != map.end())
+    {
+      std::cerr << "Unable to InsertStatistic ["
+                << _name
+                << "] since it has already been inserted."
+                << std::endl;
+      return false;
+    }
+  }
+
   this->dataPtr->stats.push_back(stat);
   return true;
 }
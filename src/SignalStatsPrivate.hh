@@ -17,6 +17,7 @@
 #ifndef IGNITION_MATH_SIGNALSTATSPRIVATE_HH_
 #define IGNITION_MATH_SIGNALSTATSPRIVATE_HH_
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <ignition/math/config.hh>
@@ -38,7 +39,7 @@ namespace ignition
       public: double extraData;
 
       /// \brief Count of data values in mean.
-      public: unsigned int count;
+      public: uint64_t count;
 
       /// \brief Clone the SignalStatisticPrivate object. Used for implementing
       /// copy semantics.
@@ -50,6 +51,93 @@ namespace ignition
       }
     };
 
+    /// \brief Private data class for the SignalQuantile class.
+    /// Implements a merging t-digest.
+    /// \sa https://arxiv.org/abs/1902.04023
+    class SignalQuantilePrivate
+    {
+      /// \brief A cluster of samples summarized by its mean and weight.
+      public: struct Centroid
+      {
+        /// \brief Mean of the samples in the centroid.
+        double mean;
+
+        /// \brief Number of samples in the centroid.
+        double weight;
+      };
+
+      /// \brief Add a weighted centroid to the unmerged buffer, merging the
+      /// buffer into the digest when it is full.
+      /// \param[in] _centroid Centroid to add.
+      public: void Add(const Centroid &_centroid);
+
+      /// \brief Merge the unmerged buffer into the digest.
+      public: void Compress();
+
+      /// \brief Estimate a quantile. Buffered samples are merged into a
+      /// copy of the digest, so this can be called from several threads.
+      /// \param[in] _quantile Quantile in the range [0, 1].
+      /// \return Estimated value, or 0 if there is no data.
+      public: double Value(double _quantile) const;
+
+      /// \brief Forget all previous data.
+      public: void Reset();
+
+      /// \brief Quantile computed by the statistic.
+      public: double quantile = 0.5;
+
+      /// \brief Merged centroids, sorted by mean.
+      public: std::vector<Centroid> centroids;
+
+      /// \brief Samples and centroids that have not been merged yet.
+      public: std::vector<Centroid> buffer;
+
+      /// \brief Scratch space used by Compress, kept to avoid allocating.
+      public: std::vector<Centroid> scratch;
+
+      /// \brief Smallest inserted value.
+      public: double min = 0.0;
+
+      /// \brief Largest inserted value.
+      public: double max = 0.0;
+
+      /// \brief Total weight of the merged centroids.
+      public: double totalWeight = 0.0;
+    };
+
+    /// \brief Private data class for the SignalWindowStatistic class.
+    /// Each derived statistic only uses the members it needs.
+    class SignalWindowPrivate
+    {
+      /// \brief Ring buffer with the samples in the window, indexed by
+      /// sample number modulo the window size.
+      public: std::vector<double> values;
+
+      /// \brief Number of samples inserted since the last reset, used as
+      /// the sample number of the next sample.
+      public: uint64_t samples = 0;
+
+      /// \brief Running sum of the samples in the window.
+      public: double sum = 0.0;
+
+      /// \brief Running mean of the samples in the window.
+      public: double mean = 0.0;
+
+      /// \brief Running sum of squared differences from the mean.
+      public: double m2 = 0.0;
+
+      /// \brief Ring buffer with the sample numbers of a monotonic queue.
+      /// The values of the queued samples are monotonic from front to back,
+      /// so the front is the extreme value of the window.
+      public: std::vector<uint64_t> queue;
+
+      /// \brief Index of the front of the monotonic queue.
+      public: size_t queueFront = 0;
+
+      /// \brief Number of sample numbers in the monotonic queue.
+      public: size_t queueSize = 0;
+    };
+
     class SignalStatistic;
 
     /// \def SignalStatisticPtr
@@ -66,6 +154,23 @@ namespace ignition
       /// \brief Vector of `SignalStatistic`s.
       public: SignalStatistic_V stats;
 
+      /// \brief Add a block of samples to each statistic. Statistics with a
+      /// block kernel reduce the whole block at once, the others insert
+      /// the samples one at a time.
+      /// \param[in] _data Array of _count samples.
+      /// \param[in] _count Number of samples.
+      public: void InsertData(const double *_data, size_t _count);
+
+      /// \brief Combine the data of a statistic into another one of the
+      /// same type, as if all samples inserted into _from had also been
+      /// inserted into _to.
+      /// \param[in, out] _to Statistic to merge into.
+      /// \param[in] _from Statistic to merge.
+      /// \return True if the statistics were merged, false if they are not
+      /// of the same type or if the type does not support merging.
+      public: static bool Merge(SignalStatistic &_to,
+                  const SignalStatistic &_from);
+
       /// \brief Clone the SignalStatsPrivate object. Used for implementing
       /// copy semantics.
       public: std::unique_ptr<SignalStatsPrivate> Clone() const
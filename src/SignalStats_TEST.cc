@@ -639,3 +639,380 @@ TEST(SignalStatsTest, SignalStats)
   }
 }
 
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, InsertDataBlock)
+{
+  // Inserting a block should match inserting each sample,
+  // including when appending to existing data. Statistics without a block
+  // kernel insert the samples one at a time.
+  const std::string names = "max,maxAbs,mean,min,rms,var,p50,windowMean:5";
+  math::SignalStats single;
+  math::SignalStats block;
+  EXPECT_TRUE(single.InsertStatistics(names));
+  EXPECT_TRUE(block.InsertStatistics(names));
+
+  // Empty block
+  block.InsertData(std::vector<double>());
+  EXPECT_EQ(block.Count(), 0u);
+
+  // Use sizes that are not a multiple of the kernel width
+  for (size_t size : {1u, 3u, 10u, 1001u})
+  {
+    std::vector<double> data;
+    for (size_t i = 0; i < size; ++i)
+      data.push_back(math::Rand::DblNormal(1.0, 10.0));
+
+    for (const double value : data)
+      single.InsertData(value);
+    block.InsertData(data);
+
+    EXPECT_EQ(single.Count(), block.Count());
+    auto singleMap = single.Map();
+    auto blockMap = block.Map();
+    for (auto const &[name, value] : singleMap)
+    {
+      EXPECT_NEAR(blockMap[name], value, 1e-9 * std::max(1.0, value))
+        << name;
+    }
+  }
+
+  // Reset
+  block.Reset();
+  EXPECT_EQ(block.Count(), 0u);
+  block.InsertData(std::vector<double>{-1.0, 2.0, -3.0});
+  auto map = block.Map();
+  EXPECT_DOUBLE_EQ(map["max"], 2.0);
+  EXPECT_DOUBLE_EQ(map["maxAbs"], 3.0);
+  EXPECT_DOUBLE_EQ(map["mean"], -2.0 / 3.0);
+  EXPECT_DOUBLE_EQ(map["min"], -3.0);
+  EXPECT_DOUBLE_EQ(map["rms"], sqrt(14.0 / 3.0));
+  EXPECT_NEAR(map["var"], 19.0 / 3.0, 1e-12);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalStatsMergeEmpty)
+{
+  const std::string names = "max,maxAbs,mean,min,rms,var,p50";
+
+  // Merging with empty statistics keeps the current values
+  math::SignalStats stats;
+  math::SignalStats empty;
+  EXPECT_TRUE(stats.InsertStatistics(names));
+  EXPECT_TRUE(empty.InsertStatistics(names));
+  stats.InsertData(-3.0);
+  EXPECT_TRUE(stats.Merge(empty));
+  EXPECT_EQ(stats.Count(), 1u);
+  auto map = stats.Map();
+  EXPECT_DOUBLE_EQ(map["max"], -3.0);
+  EXPECT_DOUBLE_EQ(map["maxAbs"], 3.0);
+  EXPECT_DOUBLE_EQ(map["mean"], -3.0);
+  EXPECT_DOUBLE_EQ(map["min"], -3.0);
+  EXPECT_DOUBLE_EQ(map["p50"], -3.0);
+
+  // Merging into empty statistics copies the values
+  stats.InsertData(-1.0);
+  stats.InsertData(-2.0);
+  EXPECT_TRUE(empty.Merge(stats));
+  EXPECT_EQ(empty.Count(), 3u);
+  map = empty.Map();
+  EXPECT_DOUBLE_EQ(map["max"], -1.0);
+  EXPECT_DOUBLE_EQ(map["min"], -3.0);
+  EXPECT_DOUBLE_EQ(map["mean"], -2.0);
+  EXPECT_DOUBLE_EQ(map["var"], 1.0);
+
+  // Merging with itself doubles the samples
+  EXPECT_TRUE(empty.Merge(empty));
+  EXPECT_EQ(empty.Count(), 6u);
+  map = empty.Map();
+  EXPECT_DOUBLE_EQ(map["mean"], -2.0);
+  EXPECT_DOUBLE_EQ(map["var"], 0.8);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalStatsMerge)
+{
+  math::SignalStats a;
+  math::SignalStats b;
+  math::SignalStats all;
+  EXPECT_TRUE(a.InsertStatistics("max,maxAbs,mean,min,rms,var"));
+  EXPECT_TRUE(b.InsertStatistics("var,rms,min,mean,maxAbs,max"));
+  EXPECT_TRUE(all.InsertStatistics("max,maxAbs,mean,min,rms,var"));
+
+  for (int i = 0; i < 100; ++i)
+  {
+    const double value = math::Rand::DblUniform(-10.0, 10.0);
+    if (i % 3 == 0)
+      a.InsertData(value);
+    else
+      b.InsertData(value);
+    all.InsertData(value);
+  }
+
+  EXPECT_TRUE(a.Merge(b));
+  EXPECT_EQ(a.Count(), all.Count());
+  auto map = a.Map();
+  for (auto const &[name, value] : all.Map())
+    EXPECT_NEAR(map[name], value, 1e-9) << name;
+
+  // Statistics must match
+  math::SignalStats c;
+  EXPECT_TRUE(c.InsertStatistics("max,mean"));
+  EXPECT_FALSE(a.Merge(c));
+  EXPECT_FALSE(c.Merge(a));
+  EXPECT_TRUE(c.InsertStatistics("maxAbs,min,rms"));
+  EXPECT_FALSE(a.Merge(c));
+  EXPECT_EQ(a.Count(), all.Count());
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, InsertDataParallel)
+{
+  std::vector<double> data;
+  for (int i = 0; i < 100000; ++i)
+    data.push_back(math::Rand::DblNormal(4.0, 2.0));
+
+  math::SignalStats serial;
+  EXPECT_TRUE(serial.InsertStatistics("max,maxAbs,mean,min,rms,var"));
+  serial.InsertData(data);
+
+  for (unsigned int threads : {0u, 1u, 3u, 8u})
+  {
+    math::SignalStats parallel;
+    EXPECT_TRUE(parallel.InsertStatistics("max,maxAbs,mean,min,rms,var"));
+    parallel.InsertData(1.0);
+    EXPECT_TRUE(parallel.InsertDataParallel(data, threads));
+    EXPECT_EQ(parallel.Count(), serial.Count() + 1);
+
+    serial.InsertData(1.0);
+    auto map = parallel.Map();
+    for (auto const &[name, value] : serial.Map())
+      EXPECT_NEAR(map[name], value, 1e-9) << name;
+    serial.Reset();
+    serial.InsertData(data);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalQuantile)
+{
+  {
+    // Constructor
+    math::SignalQuantile median;
+    EXPECT_DOUBLE_EQ(median.Quantile(), 0.5);
+    EXPECT_DOUBLE_EQ(median.Value(), 0.0);
+    EXPECT_EQ(median.Count(), 0u);
+    EXPECT_EQ(median.ShortName(), std::string("p50"));
+
+    EXPECT_EQ(math::SignalQuantile(0.99).ShortName(), "p99");
+    EXPECT_EQ(math::SignalQuantile(0.999).ShortName(), "quantile:0.999");
+    EXPECT_EQ(math::SignalQuantile(0.57).ShortName(), "p57");
+
+    // Names give back exactly the same quantile
+    for (double quantile : {1.0 / 3.0, 0.1 + 0.2, 0.57 + 1e-15})
+    {
+      const std::string name = math::SignalQuantile(quantile).ShortName();
+      ASSERT_EQ(name.compare(0, 9, "quantile:"), 0) << name;
+      EXPECT_EQ(std::stod(name.substr(9)), quantile) << name;
+    }
+    EXPECT_DOUBLE_EQ(math::SignalQuantile(2.0).Quantile(), 1.0);
+  }
+
+  {
+    // Small data sets are exact at the data points
+    math::SignalQuantile median;
+    for (const double value : {5.0, 1.0, 4.0, 2.0, 3.0})
+      median.InsertData(value);
+    EXPECT_EQ(median.Count(), 5u);
+    EXPECT_DOUBLE_EQ(median.Value(), 3.0);
+    EXPECT_DOUBLE_EQ(median.Value(0.0), 1.0);
+    EXPECT_DOUBLE_EQ(median.Value(1.0), 5.0);
+
+    // Copy
+    math::SignalQuantile copy(median);
+    EXPECT_DOUBLE_EQ(copy.Value(), 3.0);
+    EXPECT_EQ(copy.Count(), 5u);
+
+    // Reset
+    median.Reset();
+    EXPECT_DOUBLE_EQ(median.Value(), 0.0);
+    EXPECT_EQ(median.Count(), 0u);
+    EXPECT_DOUBLE_EQ(copy.Value(), 3.0);
+  }
+
+  {
+    // Uniformly distributed values
+    math::SignalQuantile p99(0.99);
+    math::SignalStats first;
+    math::SignalStats second;
+    EXPECT_TRUE(first.InsertStatistics("p50,p99"));
+    EXPECT_TRUE(second.InsertStatistics("p50,p99"));
+    for (int i = 0; i < 100000; ++i)
+    {
+      const double value = math::Rand::DblUniform(0.0, 1000.0);
+      p99.InsertData(value);
+      if (i % 2 == 0)
+        first.InsertData(value);
+      else
+        second.InsertData(value);
+    }
+
+    EXPECT_EQ(p99.Count(), 100000u);
+    EXPECT_NEAR(p99.Value(), 990.0, 2.0);
+    EXPECT_NEAR(p99.Value(0.5), 500.0, 10.0);
+    EXPECT_NEAR(p99.Value(0.01), 10.0, 2.0);
+
+    // Merged digests
+    EXPECT_TRUE(first.Merge(second));
+    EXPECT_EQ(first.Count(), 100000u);
+    auto map = first.Map();
+    EXPECT_NEAR(map["p99"], p99.Value(), 2.0);
+    EXPECT_NEAR(map["p50"], p99.Value(0.5), 10.0);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalStatsQuantiles)
+{
+  math::SignalStats stats;
+  EXPECT_TRUE(stats.InsertStatistics("p50,p99,quantile:0.999"));
+  EXPECT_FALSE(stats.InsertStatistic("quantile:0.5"));
+  EXPECT_FALSE(stats.InsertStatistic("p99.9"));
+  EXPECT_FALSE(stats.InsertStatistic("p101"));
+  EXPECT_FALSE(stats.InsertStatistic("p"));
+  EXPECT_FALSE(stats.InsertStatistic("p-1"));
+  EXPECT_FALSE(stats.InsertStatistic("quantile:"));
+  EXPECT_FALSE(stats.InsertStatistic("quantile:1.5"));
+  EXPECT_TRUE(stats.InsertStatistic("p0"));
+
+  for (int i = 0; i <= 1000; ++i)
+    stats.InsertData(i);
+
+  auto map = stats.Map();
+  EXPECT_EQ(map.size(), 4u);
+  EXPECT_NEAR(map["p0"], 0.0, 1e-9);
+  EXPECT_NEAR(map["p50"], 500.0, 1.0);
+  EXPECT_NEAR(map["p99"], 990.0, 1.0);
+  EXPECT_NEAR(map["quantile:0.999"], 999.0, 1.0);
+
+  // Parallel insertion merges the digests
+  std::vector<double> data;
+  for (int i = 0; i < 100000; ++i)
+    data.push_back(i % 1001);
+  stats.Reset();
+  EXPECT_TRUE(stats.InsertDataParallel(data, 4));
+  map = stats.Map();
+  EXPECT_NEAR(map["p50"], 500.0, 5.0);
+  EXPECT_NEAR(map["p99"], 990.0, 2.0);
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalWindowStatistics)
+{
+  const size_t windowSize = 7;
+  math::SignalWindowMaximum max(windowSize);
+  math::SignalWindowMean mean(windowSize);
+  math::SignalWindowMinimum min(windowSize);
+  math::SignalWindowVariance var(windowSize);
+
+  EXPECT_EQ(max.ShortName(), "windowMax:7");
+  EXPECT_EQ(mean.ShortName(), "windowMean:7");
+  EXPECT_EQ(min.ShortName(), "windowMin:7");
+  EXPECT_EQ(var.ShortName(), "windowVar:7");
+  EXPECT_EQ(mean.WindowSize(), windowSize);
+  EXPECT_EQ(math::SignalWindowMean(0).WindowSize(), 1u);
+
+  // No data
+  EXPECT_DOUBLE_EQ(max.Value(), 0.0);
+  EXPECT_DOUBLE_EQ(mean.Value(), 0.0);
+  EXPECT_DOUBLE_EQ(min.Value(), 0.0);
+  EXPECT_DOUBLE_EQ(var.Value(), 0.0);
+
+  // Loop two times to verify Reset
+  for (int j = 0; j < 2; ++j)
+  {
+    std::vector<double> values;
+    for (unsigned int i = 1; i <= 100; ++i)
+    {
+      // Include runs of repeated values
+      const double value = (i % 11 < 3) ? 2.0 :
+        math::Rand::DblUniform(-5.0, 5.0);
+      values.push_back(value);
+      max.InsertData(value);
+      mean.InsertData(value);
+      min.InsertData(value);
+      var.InsertData(value);
+
+      // Brute force statistics of the window
+      const size_t count = std::min<size_t>(i, windowSize);
+      std::vector<double> window(values.end() - count, values.end());
+      double sum = 0.0;
+      for (const double v : window)
+        sum += v;
+      const double windowMean = sum / count;
+      double m2 = 0.0;
+      for (const double v : window)
+        m2 += (v - windowMean) * (v - windowMean);
+
+      EXPECT_EQ(mean.Count(), i);
+      EXPECT_EQ(mean.WindowCount(), count);
+      EXPECT_DOUBLE_EQ(max.Value(),
+          *std::max_element(window.begin(), window.end()));
+      EXPECT_DOUBLE_EQ(min.Value(),
+          *std::min_element(window.begin(), window.end()));
+      EXPECT_NEAR(mean.Value(), windowMean, 1e-12);
+      EXPECT_NEAR(var.Value(), count > 1 ? m2 / (count - 1) : 0.0, 1e-12);
+    }
+
+    // Copy
+    math::SignalWindowMean meanCopy(mean);
+    EXPECT_DOUBLE_EQ(meanCopy.Value(), mean.Value());
+    EXPECT_EQ(meanCopy.WindowSize(), windowSize);
+
+    max.Reset();
+    mean.Reset();
+    min.Reset();
+    var.Reset();
+    EXPECT_EQ(mean.Count(), 0u);
+    EXPECT_EQ(mean.WindowCount(), 0u);
+    EXPECT_DOUBLE_EQ(max.Value(), 0.0);
+    EXPECT_DOUBLE_EQ(mean.Value(), 0.0);
+    EXPECT_DOUBLE_EQ(min.Value(), 0.0);
+    EXPECT_DOUBLE_EQ(var.Value(), 0.0);
+    EXPECT_EQ(meanCopy.Count(), 100u);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(SignalStatsTest, SignalStatsWindow)
+{
+  math::SignalStats stats;
+  EXPECT_TRUE(stats.InsertStatistics(
+      "windowMax:3,windowMean:3,windowMin:3,windowVar:3,mean"));
+  EXPECT_FALSE(stats.InsertStatistic("windowMean:3"));
+  EXPECT_TRUE(stats.InsertStatistic("windowMean:4"));
+  EXPECT_FALSE(stats.InsertStatistic("windowMean:0"));
+  EXPECT_FALSE(stats.InsertStatistic("windowMean:"));
+  EXPECT_FALSE(stats.InsertStatistic("windowMean:-3"));
+  EXPECT_FALSE(stats.InsertStatistic("windowMean:3.5"));
+  EXPECT_FALSE(stats.InsertStatistic("windowMean"));
+
+  stats.InsertData(std::vector<double>{10.0, 1.0, 2.0, 3.0});
+  auto map = stats.Map();
+  EXPECT_EQ(map.size(), 6u);
+  EXPECT_DOUBLE_EQ(map["windowMax:3"], 3.0);
+  EXPECT_DOUBLE_EQ(map["windowMean:3"], 2.0);
+  EXPECT_DOUBLE_EQ(map["windowMean:4"], 4.0);
+  EXPECT_DOUBLE_EQ(map["windowMin:3"], 1.0);
+  EXPECT_NEAR(map["windowVar:3"], 1.0, 1e-12);
+  EXPECT_DOUBLE_EQ(map["mean"], 4.0);
+
+  // Windowed statistics can't be merged, so data is inserted serially
+  math::SignalStats copy(stats);
+  EXPECT_FALSE(stats.Merge(copy));
+  EXPECT_EQ(stats.Count(), 4u);
+  std::vector<double> data(10000, 1.0);
+  EXPECT_FALSE(stats.InsertDataParallel(data, 2));
+  EXPECT_EQ(stats.Count(), 10004u);
+  EXPECT_DOUBLE_EQ(stats.Map()["windowMax:3"], 1.0);
+}
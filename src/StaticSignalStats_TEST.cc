@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <ignition/math/Rand.hh>
+#include <ignition/math/SignalStats.hh>
+#include <ignition/math/StaticSignalStats.hh>
+
+using namespace ignition;
+
+//////////////////////////////////////////////////
+TEST(StaticSignalStatsTest, Constructor)
+{
+  math::StaticSignalStats<math::stats::Mean, math::stats::Variance,
+      math::stats::Maximum> stats;
+  EXPECT_EQ(stats.Count(), 0u);
+  EXPECT_EQ(stats.kCount, 3u);
+  EXPECT_DOUBLE_EQ(stats.Value<math::stats::Mean>(), 0.0);
+  EXPECT_DOUBLE_EQ(stats.Value<math::stats::Variance>(), 0.0);
+  EXPECT_DOUBLE_EQ(stats.Value<math::stats::Maximum>(), 0.0);
+
+  EXPECT_EQ(stats.Index<math::stats::Mean>(), 0u);
+  EXPECT_EQ(stats.Index<math::stats::Variance>(), 1u);
+  EXPECT_EQ(stats.Index<math::stats::Maximum>(), 2u);
+  EXPECT_EQ(stats.Index<math::stats::Minimum>(), 3u);
+
+  auto names = stats.ShortNames();
+  EXPECT_EQ(std::string(names[0]), "mean");
+  EXPECT_EQ(std::string(names[1]), "var");
+  EXPECT_EQ(std::string(names[2]), "max");
+
+  EXPECT_TRUE(std::isnan(stats.Value(3)));
+}
+
+//////////////////////////////////////////////////
+TEST(StaticSignalStatsTest, Values)
+{
+  math::StaticSignalStats<math::stats::Mean, math::stats::Variance,
+      math::stats::Minimum> stats;
+
+  // Loop two times to verify Reset
+  for (int j = 0; j < 2; ++j)
+  {
+    stats.InsertData(1.0);
+    stats.InsertData(-2.0);
+    stats.InsertData(4.0);
+    EXPECT_EQ(stats.Count(), 3u);
+    EXPECT_DOUBLE_EQ(stats.Value<math::stats::Mean>(), 1.0);
+    EXPECT_DOUBLE_EQ(stats.Value<math::stats::Variance>(), 9.0);
+    EXPECT_DOUBLE_EQ(stats.Value<math::stats::Minimum>(), -2.0);
+
+    auto values = stats.Values();
+    EXPECT_DOUBLE_EQ(values[0], 1.0);
+    EXPECT_DOUBLE_EQ(values[1], 9.0);
+    EXPECT_DOUBLE_EQ(values[2], -2.0);
+    EXPECT_DOUBLE_EQ(stats.Value(1), 9.0);
+
+    stats.Reset();
+    EXPECT_EQ(stats.Count(), 0u);
+    EXPECT_DOUBLE_EQ(stats.Value<math::stats::Mean>(), 0.0);
+    EXPECT_DOUBLE_EQ(stats.Value<math::stats::Variance>(), 0.0);
+    EXPECT_DOUBLE_EQ(stats.Value<math::stats::Minimum>(), 0.0);
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(StaticSignalStatsTest, MatchesSignalStats)
+{
+  math::SignalStats dynamicStats;
+  EXPECT_TRUE(dynamicStats.InsertStatistics("max,maxAbs,mean,min,rms,var"));
+
+  math::StaticSignalStats<math::stats::Maximum,
+      math::stats::MaxAbsoluteValue, math::stats::Mean,
+      math::stats::Minimum, math::stats::RootMeanSquare,
+      math::stats::Variance> staticStats;
+
+  for (int i = 0; i < 1000; ++i)
+  {
+    const double value = math::Rand::DblNormal(3.0, 5.0);
+    dynamicStats.InsertData(value);
+    staticStats.InsertData(value);
+  }
+
+  EXPECT_EQ(dynamicStats.Count(), staticStats.Count());
+
+  auto dynamicMap = dynamicStats.Map();
+  auto staticMap = staticStats.Map();
+  ASSERT_EQ(dynamicMap.size(), staticMap.size());
+  for (auto const &[name, value] : dynamicMap)
+  {
+    ASSERT_NE(staticMap.find(name), staticMap.end()) << name;
+    EXPECT_DOUBLE_EQ(staticMap[name], value) << name;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST(StaticSignalStatsTest, Merge)
+{
+  using Stats = math::StaticSignalStats<math::stats::Maximum,
+      math::stats::MaxAbsoluteValue, math::stats::Mean,
+      math::stats::Minimum, math::stats::RootMeanSquare,
+      math::stats::Variance>;
+  Stats a;
+  Stats b;
+  Stats all;
+  for (int i = 0; i < 100; ++i)
+  {
+    const double value = math::Rand::DblUniform(-10.0, 10.0);
+    if (i < 30)
+      a.InsertData(value);
+    else
+      b.InsertData(value);
+    all.InsertData(value);
+  }
+
+  a.Merge(b);
+  EXPECT_EQ(a.Count(), all.Count());
+  for (size_t i = 0; i < Stats::kCount; ++i)
+    EXPECT_NEAR(a.Value(i), all.Value(i), 1e-9) << Stats::ShortNames()[i];
+
+  // Merging an empty object changes nothing
+  a.Merge(Stats());
+  for (size_t i = 0; i < Stats::kCount; ++i)
+    EXPECT_NEAR(a.Value(i), all.Value(i), 1e-9) << Stats::ShortNames()[i];
+}
@@ -14,12 +14,60 @@
  * limitations under the License.
  *
 */
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
 #include <ignition/math/Vector3Stats.hh>
+#include "ParallelInsert.hh"
 #include "Vector3StatsPrivate.hh"
 
 using namespace ignition;
 using namespace math;
 
+namespace
+{
+  //////////////////////////////////////////////////
+  /// \brief Add a block of samples to the statistics of each component.
+  /// \param[in, out] _stats Statistics to insert into.
+  /// \param[in] _data Array of _count samples.
+  /// \param[in] _count Number of samples.
+  void InsertBlock(Vector3StatsPrivate &_stats, const Vector3d *_data,
+      const size_t _count)
+  {
+    // Split the samples in chunks that stay in cache between the pass that
+    // computes the components and the passes of each statistic.
+    const size_t kChunkSize = 1024;
+    const size_t chunkSize = std::min(kChunkSize, _count);
+    std::vector<double> x(chunkSize);
+    std::vector<double> y(chunkSize);
+    std::vector<double> z(chunkSize);
+    std::vector<double> mag(chunkSize);
+
+    for (size_t start = 0; start < _count; start += chunkSize)
+    {
+      const size_t size = std::min(chunkSize, _count - start);
+      x.resize(size);
+      y.resize(size);
+      z.resize(size);
+      mag.resize(size);
+      for (size_t i = 0; i < size; ++i)
+      {
+        const Vector3d &data = _data[start + i];
+        x[i] = data.X();
+        y[i] = data.Y();
+        z[i] = data.Z();
+        mag[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+      }
+      _stats.x.InsertData(x);
+      _stats.y.InsertData(y);
+      _stats.z.InsertData(z);
+      _stats.mag.InsertData(mag);
+    }
+  }
+}
+
 //////////////////////////////////////////////////
 Vector3Stats::Vector3Stats()
   : dataPtr(new Vector3StatsPrivate)
@@ -42,6 +90,63 @@ void Vector3Stats::InsertData(const Vector3d &_data)
   this->dataPtr->mag.InsertData(_data.Length());
 }
 
+//////////////////////////////////////////////////
+void Vector3Stats::InsertData(const std::vector<Vector3d> &_data)
+{
+  InsertBlock(*this->dataPtr, _data.data(), _data.size());
+}
+
+//////////////////////////////////////////////////
+bool Vector3Stats::InsertDataParallel(const std::vector<Vector3d> &_data,
+    unsigned int _threadCount)
+{
+  std::vector<std::string> names;
+  for (auto const &stat : this->dataPtr->x.Map())
+    names.push_back(stat.first);
+
+  return ParallelInsert(*this, _data.data(), _data.size(), _threadCount,
+      [&names](Vector3Stats &_stats)
+      {
+        for (auto const &name : names)
+          _stats.InsertStatistic(name);
+      },
+      [](Vector3Stats &_stats, const Vector3d *_samples, size_t _count)
+      {
+        InsertBlock(*_stats.dataPtr, _samples, _count);
+      });
+}
+
+//////////////////////////////////////////////////
+bool Vector3Stats::Merge(const Vector3Stats &_other)
+{
+  // Check that all components have the same statistics first, so that
+  // nothing is modified on failure.
+  auto sameNames = [](const SignalStats &_a, const SignalStats &_b)
+  {
+    auto mapA = _a.Map();
+    auto mapB = _b.Map();
+    return std::equal(mapA.begin(), mapA.end(), mapB.begin(), mapB.end(),
+        [](const auto &_pairA, const auto &_pairB)
+        {
+          return _pairA.first == _pairB.first;
+        });
+  };
+  if (!sameNames(this->dataPtr->x, _other.dataPtr->x) ||
+      !sameNames(this->dataPtr->y, _other.dataPtr->y) ||
+      !sameNames(this->dataPtr->z, _other.dataPtr->z) ||
+      !sameNames(this->dataPtr->mag, _other.dataPtr->mag))
+  {
+    return false;
+  }
+
+  // The components share the same statistic types, so if the first merge
+  // succeeds the others do too.
+  return this->dataPtr->x.Merge(_other.dataPtr->x) &&
+         this->dataPtr->y.Merge(_other.dataPtr->y) &&
+         this->dataPtr->z.Merge(_other.dataPtr->z) &&
+         this->dataPtr->mag.Merge(_other.dataPtr->mag);
+}
+
 //////////////////////////////////////////////////
 bool Vector3Stats::InsertStatistic(const std::string &_name)
 {
@@ -187,3 +187,67 @@ TEST_F(Vector3StatsTest, Vector3Stats)
     EXPECT_NEAR(this->Mag(name), 1.0, 1e-10);
   }
 }
+
+//////////////////////////////////////////////////
+TEST_F(Vector3StatsTest, InsertDataBlock)
+{
+  math::Vector3Stats single;
+  EXPECT_TRUE(single.InsertStatistics("max,mean,min,var"));
+  EXPECT_TRUE(this->stats.InsertStatistics("max,mean,min,var"));
+
+  // More samples than a single chunk
+  std::vector<math::Vector3d> data;
+  for (int i = 0; i < 2500; ++i)
+  {
+    data.push_back(math::Vector3d(i * 0.1, -i * 0.2, (i % 7) - 3.0));
+    single.InsertData(data.back());
+  }
+  this->stats.InsertData(data);
+
+  EXPECT_EQ(this->stats.X().Count(), 2500u);
+  EXPECT_EQ(this->stats.Y().Count(), 2500u);
+  EXPECT_EQ(this->stats.Z().Count(), 2500u);
+  EXPECT_EQ(this->stats.Mag().Count(), 2500u);
+
+  for (const std::string name : {"max", "mean", "min", "var"})
+  {
+    EXPECT_NEAR(this->X(name), single.X().Map()[name], 1e-6) << name;
+    EXPECT_NEAR(this->Y(name), single.Y().Map()[name], 1e-6) << name;
+    EXPECT_NEAR(this->Z(name), single.Z().Map()[name], 1e-6) << name;
+    EXPECT_NEAR(this->Mag(name), single.Mag().Map()[name], 1e-6) << name;
+  }
+}
+
+//////////////////////////////////////////////////
+TEST_F(Vector3StatsTest, MergeAndInsertDataParallel)
+{
+  std::vector<math::Vector3d> data;
+  for (int i = 0; i < 20000; ++i)
+    data.push_back(math::Vector3d(i * 0.1, -i * 0.2, (i % 7) - 3.0));
+
+  math::Vector3Stats serial;
+  EXPECT_TRUE(serial.InsertStatistics("maxAbs,rms,var"));
+  serial.InsertData(data);
+
+  EXPECT_TRUE(this->stats.InsertStatistics("maxAbs,rms,var"));
+  EXPECT_TRUE(this->stats.InsertDataParallel(data, 4));
+  EXPECT_EQ(this->stats.Mag().Count(), 20000u);
+
+  for (const std::string name : {"maxAbs", "rms", "var"})
+  {
+    EXPECT_NEAR(this->X(name), serial.X().Map()[name], 1e-6) << name;
+    EXPECT_NEAR(this->Y(name), serial.Y().Map()[name], 1e-6) << name;
+    EXPECT_NEAR(this->Z(name), serial.Z().Map()[name], 1e-6) << name;
+    EXPECT_NEAR(this->Mag(name), serial.Mag().Map()[name], 1e-6) << name;
+  }
+
+  // Merge doubles the count but keeps these statistics
+  EXPECT_TRUE(this->stats.Merge(serial));
+  EXPECT_EQ(this->stats.X().Count(), 40000u);
+  EXPECT_NEAR(this->Mag("rms"), serial.Mag().Map()["rms"], 1e-6);
+
+  math::Vector3Stats other;
+  EXPECT_TRUE(other.InsertStatistics("maxAbs"));
+  EXPECT_FALSE(this->stats.Merge(other));
+  EXPECT_EQ(this->stats.X().Count(), 40000u);
+}
@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <thread>
+
+#include "ignition/math/VoxelGridFilter.hh"
+#include "ChunkPool.hh"
+
+using namespace ignition;
+using namespace math;
+
+namespace
+{
+/// \brief Number of points processed by each chunk of work.
+const size_t kPointsPerChunk = 1 << 16;
+
+/// \brief Largest number of bits of each radix sort pass.
+const int kRadixBits = 12;
+
+/// \brief Largest voxel index magnitude, so that index differences fit in
+/// 64 bits.
+const double kMaxVoxel = 4611686018427387904.0;
+
+/// \brief A point and the key of its voxel.
+struct Entry
+{
+  /// \brief Key of the voxel.
+  uint64_t key;
+
+  /// \brief Index of the point in the input.
+  size_t index;
+};
+
+//////////////////////////////////////////////////
+/// \brief Sort entries by key with a stable least significant digit radix
+/// sort. Each pass builds a histogram per chunk, and chunks scatter their
+/// entries to offsets ordered by digit, then by chunk. The bits are split
+/// evenly between the fewest passes of at most kRadixBits bits.
+/// \param[in] _pool Threads.
+/// \param[in] _bits Number of significant bits of the keys.
+/// \param[in,out] _entries Entries to sort.
+/// \param[in,out] _buffer Buffer of the same size as _entries.
+void RadixSort(ChunkPool &_pool, int _bits, std::vector<Entry> &_entries,
+    std::vector<Entry> &_buffer)
+{
+  const size_t count = _entries.size();
+  const size_t chunks = (count + kPointsPerChunk - 1) / kPointsPerChunk;
+  const int passes = (_bits + kRadixBits - 1) / kRadixBits;
+  const int digitBits = passes > 0 ? (_bits + passes - 1) / passes : 0;
+  const size_t buckets = size_t(1) << digitBits;
+  std::vector<size_t> offsets(chunks * buckets);
+
+  for (int shift = 0; shift < _bits; shift += digitBits)
+  {
+    const Entry *in = _entries.data();
+    Entry *out = _buffer.data();
+    _pool.Run(chunks, [&](size_t _c)
+    {
+      size_t *histogram = &offsets[_c * buckets];
+      std::fill(histogram, histogram + buckets, 0u);
+      const size_t end = std::min(count, (_c + 1) * kPointsPerChunk);
+      for (size_t i = _c * kPointsPerChunk; i < end; ++i)
+        ++histogram[(in[i].key >> shift) & (buckets - 1)];
+    });
+
+    // Skip the pass if all keys have the same digit.
+    bool single = false;
+    size_t sum = 0;
+    for (size_t d = 0; d < buckets; ++d)
+    {
+      size_t bucket = 0;
+      for (size_t c = 0; c < chunks; ++c)
+      {
+        const size_t n = offsets[c * buckets + d];
+        offsets[c * buckets + d] = sum;
+        sum += n;
+        bucket += n;
+      }
+      single = single || bucket == count;
+    }
+    if (single)
+      continue;
+
+    _pool.Run(chunks, [&](size_t _c)
+    {
+      size_t *offset = &offsets[_c * buckets];
+      const size_t end = std::min(count, (_c + 1) * kPointsPerChunk);
+      for (size_t i = _c * kPointsPerChunk; i < end; ++i)
+        out[offset[(in[i].key >> shift) & (buckets - 1)]++] = in[i];
+    });
+    std::swap(_entries, _buffer);
+  }
+}
+}
+
+/// \brief Private data for the VoxelGridFilter class.
+class ignition::math::VoxelGridFilterPrivate
+{
+  /// \brief Size of the voxels.
+  public: double voxelSize = 0;
+
+  /// \brief Point kept for each voxel.
+  public: VoxelGridFilter::RepresentativeType representative =
+    VoxelGridFilter::CENTROID;
+
+  /// \brief Number of threads used by Filter.
+  public: unsigned int threads = 1;
+};
+
+//////////////////////////////////////////////////
+VoxelGridFilter::VoxelGridFilter(double _voxelSize,
+    RepresentativeType _representative)
+  : dataPtr(new VoxelGridFilterPrivate)
+{
+  this->dataPtr->voxelSize = _voxelSize;
+  this->dataPtr->representative = _representative;
+}
+
+//////////////////////////////////////////////////
+VoxelGridFilter::~VoxelGridFilter()
+{
+}
+
+//////////////////////////////////////////////////
+double VoxelGridFilter::VoxelSize() const
+{
+  return this->dataPtr->voxelSize;
+}
+
+//////////////////////////////////////////////////
+void VoxelGridFilter::VoxelSize(double _voxelSize)
+{
+  this->dataPtr->voxelSize = _voxelSize;
+}
+
+//////////////////////////////////////////////////
+VoxelGridFilter::RepresentativeType VoxelGridFilter::Representative() const
+{
+  return this->dataPtr->representative;
+}
+
+//////////////////////////////////////////////////
+void VoxelGridFilter::Representative(RepresentativeType _representative)
+{
+  this->dataPtr->representative = _representative;
+}
+
+//////////////////////////////////////////////////
+void VoxelGridFilter::Threads(unsigned int _threads)
+{
+  if (_threads == 0)
+    _threads = std::max(1u, std::thread::hardware_concurrency());
+  this->dataPtr->threads = _threads;
+}
+
+//////////////////////////////////////////////////
+unsigned int VoxelGridFilter::Threads() const
+{
+  return this->dataPtr->threads;
+}
+
+//////////////////////////////////////////////////
+bool VoxelGridFilter::Filter(const std::vector<Vector3d> &_points,
+    std::vector<Vector3d> &_output)
+{
+  return this->Filter(_points.data(), _points.size(), _output);
+}
+
+//////////////////////////////////////////////////
+bool VoxelGridFilter::Filter(const Vector3d *_points, size_t _count,
+    std::vector<Vector3d> &_output)
+{
+  _output.clear();
+  if (_count > 0 && !_points)
+  {
+    std::cerr << "VoxelGridFilter error: null points" << std::endl;
+    return false;
+  }
+
+  const double size = this->dataPtr->voxelSize;
+  if (!(size > 0) || !std::isfinite(size))
+  {
+    std::cerr << "VoxelGridFilter error: the voxel size has to be positive"
+              << " and finite but its value is [" << size << "]"
+              << std::endl;
+    return false;
+  }
+
+  const size_t chunks = (_count + kPointsPerChunk - 1) / kPointsPerChunk;
+  ChunkPool pool(static_cast<unsigned int>(
+        std::min<size_t>(this->dataPtr->threads, std::max<size_t>(chunks, 1))));
+
+  // Range of voxel indices and number of finite points of each chunk.
+  std::vector<Vector3d> chunkMin(chunks);
+  std::vector<Vector3d> chunkMax(chunks);
+  std::vector<size_t> chunkCount(chunks);
+  pool.Run(chunks, [&](size_t _c)
+  {
+    Vector3d min(HUGE_VAL, HUGE_VAL, HUGE_VAL);
+    Vector3d max(-HUGE_VAL, -HUGE_VAL, -HUGE_VAL);
+    size_t finite = 0;
+    const size_t end = std::min(_count, (_c + 1) * kPointsPerChunk);
+    for (size_t i = _c * kPointsPerChunk; i < end; ++i)
+    {
+      if (!_points[i].IsFinite())
+        continue;
+      const Vector3d voxel(std::floor(_points[i].X() / size),
+          std::floor(_points[i].Y() / size),
+          std::floor(_points[i].Z() / size));
+      min.Min(voxel);
+      max.Max(voxel);
+      ++finite;
+    }
+    chunkMin[_c] = min;
+    chunkMax[_c] = max;
+    chunkCount[_c] = finite;
+  });
+
+  Vector3d min(HUGE_VAL, HUGE_VAL, HUGE_VAL);
+  Vector3d max(-HUGE_VAL, -HUGE_VAL, -HUGE_VAL);
+  size_t finite = 0;
+  for (size_t c = 0; c < chunks; ++c)
+  {
+    min.Min(chunkMin[c]);
+    max.Max(chunkMax[c]);
+    const size_t n = chunkCount[c];
+    chunkCount[c] = finite;
+    finite += n;
+  }
+  if (finite == 0)
+    return true;
+
+  // Pack the voxel indices relative to the smallest ones into keys that
+  // increase with z, then y, then x. The number of voxels is checked in
+  // double precision so that the keys cannot overflow.
+  double total = 1;
+  uint64_t dims[3];
+  int64_t origin[3];
+  for (int a = 0; a < 3; ++a)
+  {
+    if (std::max(std::abs(min[a]), std::abs(max[a])) > kMaxVoxel)
+      total = HUGE_VAL;
+    total *= max[a] - min[a] + 1;
+    if (total > 2 * kMaxVoxel)
+    {
+      std::cerr << "VoxelGridFilter error: voxel size [" << size << "] is"
+                << " too small for the extent of the points" << std::endl;
+      return false;
+    }
+    dims[a] = static_cast<uint64_t>(max[a] - min[a] + 1);
+    origin[a] = static_cast<int64_t>(min[a]);
+  }
+
+  std::vector<Entry> entries(finite);
+  pool.Run(chunks, [&](size_t _c)
+  {
+    size_t next = chunkCount[_c];
+    const size_t end = std::min(_count, (_c + 1) * kPointsPerChunk);
+    for (size_t i = _c * kPointsPerChunk; i < end; ++i)
+    {
+      const Vector3d &p = _points[i];
+      if (!p.IsFinite())
+        continue;
+
+      uint64_t voxel[3];
+      for (int a = 0; a < 3; ++a)
+      {
+        voxel[a] = static_cast<uint64_t>(
+            static_cast<int64_t>(std::floor(p[a] / size)) - origin[a]);
+      }
+      entries[next].key = (voxel[0] * dims[1] + voxel[1]) * dims[2] + voxel[2];
+      entries[next].index = i;
+      ++next;
+    }
+  });
+
+  int bits = 0;
+  const uint64_t keyCount = dims[0] * dims[1] * dims[2];
+  for (uint64_t last = keyCount - 1; last > 0; last >>= 1)
+    ++bits;
+  {
+    std::vector<Entry> buffer(finite);
+    RadixSort(pool, bits, entries, buffer);
+  }
+
+  // Count the voxels starting in each chunk of sorted entries, so that
+  // chunks write their voxels at known offsets.
+  const size_t sortedChunks = (finite + kPointsPerChunk - 1) / kPointsPerChunk;
+  std::vector<size_t> voxelOffset(sortedChunks);
+  pool.Run(sortedChunks, [&](size_t _c)
+  {
+    size_t voxels = 0;
+    const size_t end = std::min(finite, (_c + 1) * kPointsPerChunk);
+    for (size_t s = _c * kPointsPerChunk; s < end; ++s)
+      voxels += s == 0 || entries[s].key != entries[s - 1].key;
+    voxelOffset[_c] = voxels;
+  });
+
+  size_t voxels = 0;
+  for (size_t &offset : voxelOffset)
+  {
+    const size_t n = offset;
+    offset = voxels;
+    voxels += n;
+  }
+  _output.resize(voxels);
+
+  // Entries of a voxel are in input order, since the sort is stable.
+  const RepresentativeType representative = this->dataPtr->representative;
+  pool.Run(sortedChunks, [&](size_t _c)
+  {
+    size_t next = voxelOffset[_c];
+    const size_t end = std::min(finite, (_c + 1) * kPointsPerChunk);
+    for (size_t s = _c * kPointsPerChunk; s < end; ++s)
+    {
+      if (s > 0 && entries[s].key == entries[s - 1].key)
+        continue;
+
+      size_t last = s + 1;
+      while (last < finite && entries[last].key == entries[s].key)
+        ++last;
+
+      Vector3d &result = _output[next++];
+      if (representative == CENTROID)
+      {
+        result = Vector3d::Zero;
+        for (size_t t = s; t < last; ++t)
+          result += _points[entries[t].index];
+        result /= static_cast<double>(last - s);
+      }
+      else if (representative == NEAREST)
+      {
+        const uint64_t key = entries[s].key;
+        const Vector3d center(
+            (static_cast<double>(key / (dims[1] * dims[2])) + origin[0] + 0.5)
+              * size,
+            (static_cast<double>((key / dims[2]) % dims[1]) + origin[1] + 0.5)
+              * size,
+            (static_cast<double>(key % dims[2]) + origin[2] + 0.5) * size);
+        double best = HUGE_VAL;
+        for (size_t t = s; t < last; ++t)
+        {
+          const Vector3d &p = _points[entries[t].index];
+          const double d = (p - center).SquaredLength();
+          if (d < best)
+          {
+            best = d;
+            result = p;
+          }
+        }
+      }
+      else
+      {
+        result = _points[entries[s].index];
+      }
+    }
+  });
+  return true;
+}
@@ -0,0 +1,181 @@
+/*
+ * Copyright (C) 2021 Open Source Robotics Foundation
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ *
+*/
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <tuple>
+#include <vector>
+
+#include "ignition/math/Helpers.hh"
+#include "ignition/math/RandomGenerator.hh"
+#include "ignition/math/VoxelGridFilter.hh"
+
+using namespace ignition;
+
+/// \brief Downsample points with a map from voxel indices to points.
+/// \param[in] _points Points.
+/// \param[in] _size Size of the voxels.
+/// \param[in] _representative Point kept for each voxel.
+/// \return One point per voxel, ordered like VoxelGridFilter.
+std::vector<math::Vector3d> Reference(
+    const std::vector<math::Vector3d> &_points, double _size,
+    math::VoxelGridFilter::RepresentativeType _representative)
+{
+  using Voxel = std::tuple<int64_t, int64_t, int64_t>;
+  std::map<Voxel, std::vector<math::Vector3d>> voxels;
+  for (const auto &p : _points)
+  {
+    if (!p.IsFinite())
+      continue;
+    voxels[Voxel(static_cast<int64_t>(std::floor(p.X() / _size)),
+        static_cast<int64_t>(std::floor(p.Y() / _size)),
+        static_cast<int64_t>(std::floor(p.Z() / _size)))].push_back(p);
+  }
+
+  std::vector<math::Vector3d> result;
+  for (const auto &voxel : voxels)
+  {
+    const std::vector<math::Vector3d> &points = voxel.second;
+    if (_representative == math::VoxelGridFilter::FIRST)
+    {
+      result.push_back(points.front());
+    }
+    else if (_representative == math::VoxelGridFilter::CENTROID)
+    {
+      math::Vector3d sum;
+      for (const auto &p : points)
+        sum += p;
+      result.push_back(sum / static_cast<double>(points.size()));
+    }
+    else
+    {
+      const math::Vector3d center(
+          (std::get<0>(voxel.first) + 0.5) * _size,
+          (std::get<1>(voxel.first) + 0.5) * _size,
+          (std::get<2>(voxel.first) + 0.5) * _size);
+      math::Vector3d best = points.front();
+      for (const auto &p : points)
+      {
+        if (p.Distance(center) < best.Distance(center))
+          best = p;
+      }
+      result.push_back(best);
+    }
+  }
+  return result;
+}
+
+//////////////////////////////////////////////////
+TEST(VoxelGridFilterTest, Parameters)
+{
+  math::VoxelGridFilter filter(0.5);
+  EXPECT_DOUBLE_EQ(filter.VoxelSize(), 0.5);
+  EXPECT_EQ(filter.Representative(), math::VoxelGridFilter::CENTROID);
+  EXPECT_EQ(filter.Threads(), 1u);
+
+  filter.VoxelSize(0.25);
+  filter.Representative(math::VoxelGridFilter::NEAREST);
+  filter.Threads(0);
+  EXPECT_DOUBLE_EQ(filter.VoxelSize(), 0.25);
+  EXPECT_EQ(filter.Representative(), math::VoxelGridFilter::NEAREST);
+  EXPECT_GE(filter.Threads(), 1u);
+
+  // Invalid input
+  std::vector<math::Vector3d> output = {math::Vector3d::One};
+  EXPECT_FALSE(filter.Filter(nullptr, 2, output));
+  EXPECT_TRUE(output.empty());
+  for (double size : {0.0, -1.0, std::nan(""), math::INF_D})
+  {
+    filter.VoxelSize(size);
+    EXPECT_FALSE(filter.Filter({math::Vector3d::Zero}, output));
+  }
+  filter.VoxelSize(1e-300);
+  EXPECT_FALSE(filter.Filter({math::Vector3d::Zero, math::Vector3d::One},
+      output));
+
+  // No finite points
+  filter.VoxelSize(1.0);
+  EXPECT_TRUE(filter.Filter({}, output));
+  EXPECT_TRUE(output.empty());
+  EXPECT_TRUE(filter.Filter({math::Vector3d(math::NAN_D, 0, 0)}, output));
+  EXPECT_TRUE(output.empty());
+}
+
+//////////////////////////////////////////////////
+TEST(VoxelGridFilterTest, Voxels)
+{
+  // Voxels are aligned with the origin
+  math::VoxelGridFilter filter(1.0, math::VoxelGridFilter::FIRST);
+  std::vector<math::Vector3d> output;
+  ASSERT_TRUE(filter.Filter({{0.5, 0.5, 0.5}, {-0.5, 0.5, 0.5},
+      {0.9, 0.1, 0.2}, {-0.1, 0.5, 0.5}, {0.5, 0.5, -2.5},
+      {math::INF_D, 0, 0}}, output));
+  ASSERT_EQ(output.size(), 3u);
+  EXPECT_EQ(output[0], math::Vector3d(-0.5, 0.5, 0.5));
+  EXPECT_EQ(output[1], math::Vector3d(0.5, 0.5, -2.5));
+  EXPECT_EQ(output[2], math::Vector3d(0.5, 0.5, 0.5));
+
+  filter.Representative(math::VoxelGridFilter::CENTROID);
+  ASSERT_TRUE(filter.Filter({{0.5, 0.5, 0.5}, {0.9, 0.1, 0.2},
+      {0.1, 0.3, 0.8}}, output));
+  ASSERT_EQ(output.size(), 1u);
+  EXPECT_EQ(output[0], math::Vector3d(0.5, 0.3, 0.5));
+
+  filter.Representative(math::VoxelGridFilter::NEAREST);
+  ASSERT_TRUE(filter.Filter({{0.9, 0.1, 0.2}, {0.4, 0.6, 0.5},
+      {0.5, 0.5, 0.5}, {0.6, 0.4, 0.5}}, output));
+  ASSERT_EQ(output.size(), 1u);
+  EXPECT_EQ(output[0], math::Vector3d(0.5, 0.5, 0.5));
+}
+
+//////////////////////////////////////////////////
+TEST(VoxelGridFilterTest, Reference)
+{
+  // Enough points for several chunks, with a dense and a sparse region
+  math::RandomGenerator generator(7);
+  std::vector<math::Vector3d> points(150000);
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const double extent = i % 2 ? 2.0 : 40.0;
+    points[i].Set(generator.DblUniform(-extent, extent),
+        generator.DblUniform(-extent, extent), generator.DblUniform(-1, 3));
+  }
+  points[10].Set(math::NAN_D, 0, 0);
+
+  for (auto representative : {math::VoxelGridFilter::CENTROID,
+      math::VoxelGridFilter::FIRST, math::VoxelGridFilter::NEAREST})
+  {
+    for (double size : {0.05, 0.3, 4.0})
+    {
+      math::VoxelGridFilter filter(size, representative);
+      std::vector<math::Vector3d> output;
+      ASSERT_TRUE(filter.Filter(points, output));
+      EXPECT_EQ(output, Reference(points, size, representative));
+
+      // Results do not depend on the number of threads
+      for (unsigned int threads : {2u, 5u})
+      {
+        filter.Threads(threads);
+        std::vector<math::Vector3d> threaded;
+        ASSERT_TRUE(filter.Filter(points.data(), points.size(), threaded));
+        EXPECT_EQ(threaded, output);
+      }
+    }
+  }
+}